@@ -15,6 +15,7 @@ struct NotifyFactionsChanges;
 struct NotifyRemoveCharacter;
 struct NotifyCharacterTravel;
 struct NotifySpawnData;
+struct NotifyCharacterSpawnBatch;
 
 struct Actor;
 struct World;
@@ -34,6 +35,7 @@ struct CharacterService
     void OnDisconnected(const DisconnectedEvent& acDisconnectedEvent) const noexcept;
     void OnAssignCharacter(const AssignCharacterResponse& acMessage) const noexcept;
     void OnCharacterSpawn(const CharacterSpawnRequest& acMessage) const noexcept;
+    void OnCharacterSpawnBatch(const NotifyCharacterSpawnBatch& acMessage) const noexcept;
     void OnReferencesMoveRequest(const ServerReferencesMoveRequest& acMessage) const noexcept;
     void OnActionEvent(const ActionEvent& acActionEvent) const noexcept;
     void OnEquipmentChangeEvent(const EquipmentChangeEvent& acEvent) noexcept;
@@ -78,6 +80,7 @@ private:
     entt::scoped_connection m_disconnectedConnection;
     entt::scoped_connection m_assignCharacterConnection;
     entt::scoped_connection m_characterSpawnConnection;
+    entt::scoped_connection m_characterSpawnBatchConnection;
     entt::scoped_connection m_characterTravelConnection;
     entt::scoped_connection m_referenceMovementSnapshotConnection;
     entt::scoped_connection m_remoteSpawnDataReceivedConnection;
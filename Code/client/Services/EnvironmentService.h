@@ -19,19 +19,29 @@ public:
     void OnDisconnected(const DisconnectedEvent &) noexcept;
 
     void ToggleGameClock(bool aEnable);
-    float TimeInterpolate(const TimeModel& aFrom, TimeModel& aTo) const;
+    float TimeInterpolate(float aFrom, float aTo) const;
+
+    // The game's own clock, restored once we leave the server
+    struct OfflineTime
+    {
+        int Year = 1;
+        int Month = 1;
+        int Day = 1;
+        float Hour = 12.f;
+        float TimeScale = 20.f;
+    };
 
     entt::scoped_connection m_timeUpdateConnection;
     entt::scoped_connection m_weatherUpdateConnection;
     entt::scoped_connection m_updateConnection;
     entt::scoped_connection m_disconnectedConnection;
 
+    // Extrapolated from the server's epoch every frame, the server only resends it when the clock changes
     TimeModel m_onlineTime;
-    TimeModel m_offlineTime;
+    OfflineTime m_offlineTime;
     float m_fadeTimer = 0.f;
     bool m_switchToOffline = false;
     static bool s_gameClockLocked;
 
-    uint64_t m_lastTick = 0;
     World& m_world;
 };
@@ -41,6 +41,7 @@
 #include <Messages/ServerReferencesMoveRequest.h>
 #include <Messages/ClientReferencesMoveRequest.h>
 #include <Messages/CharacterSpawnRequest.h>
+#include <Messages/NotifyCharacterSpawnBatch.h>
 #include <Messages/RequestInventoryChanges.h>
 #include <Messages/RequestFactionsChanges.h>
 #include <Messages/NotifyInventoryChanges.h>
@@ -71,6 +72,7 @@ CharacterService::CharacterService(World& aWorld, entt::dispatcher& aDispatcher,
 
     m_assignCharacterConnection = m_dispatcher.sink<AssignCharacterResponse>().connect<&CharacterService::OnAssignCharacter>(this);
     m_characterSpawnConnection = m_dispatcher.sink<CharacterSpawnRequest>().connect<&CharacterService::OnCharacterSpawn>(this);
+    m_characterSpawnBatchConnection = m_dispatcher.sink<NotifyCharacterSpawnBatch>().connect<&CharacterService::OnCharacterSpawnBatch>(this);
     m_referenceMovementSnapshotConnection = m_dispatcher.sink<ServerReferencesMoveRequest>().connect<&CharacterService::OnReferencesMoveRequest>(this);
     m_equipmentConnection = m_dispatcher.sink<EquipmentChangeEvent>().connect<&CharacterService::OnEquipmentChangeEvent>(this);
     m_inventoryConnection = m_dispatcher.sink<NotifyInventoryChanges>().connect<&CharacterService::OnInventoryChanges>(this);
@@ -340,6 +342,12 @@ void CharacterService::OnRemoteSpawnDataReceived(const NotifySpawnData& acEvent)
     }
 }
 
+void CharacterService::OnCharacterSpawnBatch(const NotifyCharacterSpawnBatch& acMessage) const noexcept
+{
+    for (const auto& spawn : acMessage.Spawns)
+        OnCharacterSpawn(spawn);
+}
+
 void CharacterService::OnReferencesMoveRequest(const ServerReferencesMoveRequest& acMessage) const noexcept
 {
     auto view = m_world.view<RemoteComponent, InterpolationComponent, RemoteAnimationComponent>();
@@ -569,7 +577,7 @@ void CharacterService::RequestServerAssignment(entt::registry& aRegistry, const
 
     if (isPlayer)
     {
-        auto& questLog = message.QuestContent.Entries;
+        auto& questLog = message.QuestContent;
         auto& modSystem = m_world.GetModSystem();
 
         for (const auto& objective : PlayerCharacter::Get()->objectives)
@@ -582,18 +590,11 @@ void CharacterService::RequestServerAssignment(entt::registry& aRegistry, const
             {
                 GameId id{};
 
+                // Several objectives can belong to the same quest, the log only keeps it once
                 if (modSystem.GetServerModId(pQuest->formID, id))
-                {
-                    auto& entry = questLog.emplace_back();
-                    entry.Stage = pQuest->currentStage;
-                    entry.Id = id;
-                }
+                    questLog.Set(id, pQuest->currentStage);
             }
         }
-
-        // remove duplicates
-        const auto ip = std::unique(questLog.begin(), questLog.end());
-        questLog.resize(std::distance(questLog.begin(), ip));
     }
 
     message.InventoryContent = pActor->GetInventory();
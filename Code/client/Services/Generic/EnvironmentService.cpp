@@ -27,10 +27,18 @@ EnvironmentService::EnvironmentService(World& aWorld, entt::dispatcher& aDispatc
 
 void EnvironmentService::OnTimeUpdate(const ServerTimeSettings& acMessage) noexcept
 {
-    // disable the game clock
-    m_onlineTime.TimeScale = acMessage.TimeScale;
-    m_onlineTime.Time = acMessage.Time;
-    ToggleGameClock(false);
+    m_onlineTime.GameTime = acMessage.GameTime;
+    m_onlineTime.EpochTick = acMessage.EpochTick;
+    m_onlineTime.Rate = acMessage.Rate;
+
+    // disable the game clock, later updates only change the model
+    if (!s_gameClockLocked)
+    {
+        ToggleGameClock(false);
+        m_fadeTimer = 0.f;
+    }
+
+    m_switchToOffline = false;
 }
 
 void EnvironmentService::OnDisconnected(const DisconnectedEvent&) noexcept
@@ -40,19 +48,19 @@ void EnvironmentService::OnDisconnected(const DisconnectedEvent&) noexcept
     m_switchToOffline = true;
 }
 
-float EnvironmentService::TimeInterpolate(const TimeModel& aFrom, TimeModel& aTo) const
+float EnvironmentService::TimeInterpolate(float aFrom, float aTo) const
 {
-    const auto t = aTo.Time - aFrom.Time;
+    const auto t = aTo - aFrom;
     if (t < 0.f)
     {
         const auto v = t + 24.f;
         // interpolate on the time difference, not the time
-        const auto x = TiltedPhoques::Lerp(0.f, v, m_fadeTimer / kTransitionSpeed) + aFrom.Time;
+        const auto x = TiltedPhoques::Lerp(0.f, v, m_fadeTimer / kTransitionSpeed) + aFrom;
 
         return TiltedPhoques::Mod(x, 24.f);
     }
     
-    return TiltedPhoques::Lerp(aFrom.Time, aTo.Time, m_fadeTimer / kTransitionSpeed);
+    return TiltedPhoques::Lerp(aFrom, aTo, m_fadeTimer / kTransitionSpeed);
 }
 
 void EnvironmentService::ToggleGameClock(bool aEnable)
@@ -64,8 +72,8 @@ void EnvironmentService::ToggleGameClock(bool aEnable)
         pGameTime->GameMonth->i = m_offlineTime.Month;
         pGameTime->GameYear->i = m_offlineTime.Year;
         pGameTime->TimeScale->f = m_offlineTime.TimeScale;
-        pGameTime->GameDaysPassed->f = (m_offlineTime.Time * (1.f / 24.f)) + m_offlineTime.Day;
-        pGameTime->GameHour->f = m_offlineTime.Time;
+        pGameTime->GameDaysPassed->f = (m_offlineTime.Hour * (1.f / 24.f)) + m_offlineTime.Day;
+        pGameTime->GameHour->f = m_offlineTime.Hour;
         m_switchToOffline = false;
     }
     else
@@ -73,7 +81,7 @@ void EnvironmentService::ToggleGameClock(bool aEnable)
         m_offlineTime.Day = pGameTime->GameDay->i;
         m_offlineTime.Month = pGameTime->GameMonth->i;
         m_offlineTime.Year = pGameTime->GameYear->i;
-        m_offlineTime.Time = pGameTime->GameHour->f;
+        m_offlineTime.Hour = pGameTime->GameHour->f;
         m_offlineTime.TimeScale = pGameTime->TimeScale->f;
     }
 
@@ -82,54 +90,41 @@ void EnvironmentService::ToggleGameClock(bool aEnable)
 
 void EnvironmentService::HandleUpdate(const UpdateEvent& aEvent) noexcept
 {
-    if (s_gameClockLocked)
+    if (!s_gameClockLocked)
+        return;
+
+    const auto updateDelta = static_cast<float>(aEvent.Delta);
+    auto* pGameTime = TimeData::Get();
+
+    // The tick is synchronized with the server so every client derives the same time from the model
+    const auto cTick = m_world.GetTick();
+    const auto cOnlineHour = m_onlineTime.GetHour(cTick);
+
+    if (m_switchToOffline)
     {
-        const auto updateDelta = static_cast<float>(aEvent.Delta);
-        auto* pGameTime = TimeData::Get();
-
-        if (!m_lastTick)
-            m_lastTick = m_world.GetTick();
-
-        const auto now = m_world.GetTick();
-
-        if (m_switchToOffline)
-        {
-            // time transition out
-            if (m_fadeTimer < kTransitionSpeed)
-            {
-                pGameTime->GameHour->f = TimeInterpolate(m_onlineTime, m_offlineTime);
-                // before we quit here we fire this event
-                if ((m_fadeTimer + updateDelta) > kTransitionSpeed)
-                {
-                    m_fadeTimer += updateDelta;
-                    ToggleGameClock(true);
-                }
-                else
-                    m_fadeTimer += updateDelta;
-            }
-        }
-
-        // we got disconnected or the client got ahead of us
-        if (now < m_lastTick)
-            return;
-
-        const auto delta = now - m_lastTick;
-        m_lastTick = now;
-
-        m_onlineTime.Update(delta);
-        pGameTime->GameDay->i = m_onlineTime.Day;
-        pGameTime->GameMonth->i = m_onlineTime.Month;
-        pGameTime->GameYear->i = m_onlineTime.Year;
-        pGameTime->TimeScale->f = m_onlineTime.TimeScale;
-        pGameTime->GameDaysPassed->f = (m_onlineTime.Time * (1.f / 24.f)) + m_onlineTime.Day;
-
-        // time transition in
+        // time transition out
+        m_fadeTimer += updateDelta;
         if (m_fadeTimer < kTransitionSpeed)
-        {
-            pGameTime->GameHour->f = TimeInterpolate(m_offlineTime, m_onlineTime);
-            m_fadeTimer += updateDelta;
-        }
+            pGameTime->GameHour->f = TimeInterpolate(cOnlineHour, m_offlineTime.Hour);
         else
-            pGameTime->GameHour->f = m_onlineTime.Time;
+            ToggleGameClock(true);
+
+        return;
     }
+
+    const auto cDate = m_onlineTime.GetDate(cTick);
+    pGameTime->GameDay->i = cDate.Day;
+    pGameTime->GameMonth->i = cDate.Month;
+    pGameTime->GameYear->i = cDate.Year;
+    pGameTime->TimeScale->f = m_onlineTime.GetTimeScale();
+    pGameTime->GameDaysPassed->f = (cOnlineHour * (1.f / 24.f)) + cDate.Day;
+
+    // time transition in
+    if (m_fadeTimer < kTransitionSpeed)
+    {
+        pGameTime->GameHour->f = TimeInterpolate(m_offlineTime.Hour, cOnlineHour);
+        m_fadeTimer += updateDelta;
+    }
+    else
+        pGameTime->GameHour->f = cOnlineHour;
 }
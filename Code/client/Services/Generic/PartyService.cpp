@@ -9,6 +9,8 @@
 #include <Services/TransportService.h>
 
 #include <Messages/NotifyPlayerList.h>
+#include <Messages/NotifyPlayerJoined.h>
+#include <Messages/NotifyPlayerLeft.h>
 #include <Messages/NotifyPartyInfo.h>
 #include <Messages/NotifyPartyInvite.h>
 #include <Messages/PartyInviteRequest.h>
@@ -22,8 +24,11 @@ PartyService::PartyService(entt::dispatcher& aDispatcher, ImguiService& aImguiSe
     m_drawConnection = aImguiService.OnDraw.connect<&PartyService::OnDraw>(this);
 
     m_playerListConnection = aDispatcher.sink<NotifyPlayerList>().connect<&PartyService::OnPlayerList>(this);
+    m_playerJoinedConnection = aDispatcher.sink<NotifyPlayerJoined>().connect<&PartyService::OnPlayerJoined>(this);
+    m_playerLeftConnection = aDispatcher.sink<NotifyPlayerLeft>().connect<&PartyService::OnPlayerLeft>(this);
     m_partyInfoConnection = aDispatcher.sink<NotifyPartyInfo>().connect<&PartyService::OnPartyInfo>(this);
     m_partyInviteConnection = aDispatcher.sink<NotifyPartyInvite>().connect<&PartyService::OnPartyInvite>(this);
+    m_partyMemberStatesConnection = aDispatcher.sink<NotifyPartyMemberStates>().connect<&PartyService::OnPartyMemberStates>(this);
 }
 
 void PartyService::OnUpdate(const UpdateEvent& acEvent) noexcept
@@ -52,11 +57,46 @@ void PartyService::OnUpdate(const UpdateEvent& acEvent) noexcept
 void PartyService::OnPlayerList(const NotifyPlayerList& acPlayerList) noexcept
 {
     m_players = acPlayerList.Players;
+    m_playerListVersion = acPlayerList.Version;
+}
+
+void PartyService::OnPlayerJoined(const NotifyPlayerJoined& acPlayerJoined) noexcept
+{
+    // Already part of the full list we received
+    if (acPlayerJoined.Version <= m_playerListVersion)
+        return;
+
+    m_players[acPlayerJoined.PlayerId] = acPlayerJoined.Username;
+    m_playerListVersion = acPlayerJoined.Version;
+}
+
+void PartyService::OnPlayerLeft(const NotifyPlayerLeft& acPlayerLeft) noexcept
+{
+    if (acPlayerLeft.Version <= m_playerListVersion)
+        return;
+
+    m_players.erase(acPlayerLeft.PlayerId);
+    m_invitations.erase(acPlayerLeft.PlayerId);
+    m_playerListVersion = acPlayerLeft.Version;
 }
 
 void PartyService::OnPartyInfo(const NotifyPartyInfo& acPlayerList) noexcept
 {
     m_partyMembers = acPlayerList.PlayerIds;
+
+    // Drop the states of players that left the party
+    auto itor = std::begin(m_memberStates);
+    while (itor != std::end(m_memberStates))
+    {
+        if (std::find(std::begin(m_partyMembers), std::end(m_partyMembers), itor->first) == std::end(m_partyMembers))
+        {
+            itor = m_memberStates.erase(itor);
+        }
+        else
+        {
+            ++itor;
+        }
+    }
 }
 
 void PartyService::OnPartyInvite(const NotifyPartyInvite& acPartyInvite) noexcept
@@ -64,6 +104,12 @@ void PartyService::OnPartyInvite(const NotifyPartyInvite& acPartyInvite) noexcep
     m_invitations[acPartyInvite.InviterId] = acPartyInvite.ExpiryTick;
 }
 
+void PartyService::OnPartyMemberStates(const NotifyPartyMemberStates& acMemberStates) noexcept
+{
+    for (const auto& member : acMemberStates.Members)
+        m_memberStates[member.PlayerId] = member;
+}
+
 void PartyService::OnDraw() noexcept
 {
     if (!m_transportService.IsConnected())
@@ -76,7 +122,18 @@ void PartyService::OnDraw() noexcept
         ImGui::Text(player.second.c_str());
 
         if (std::find(std::begin(m_partyMembers), std::end(m_partyMembers), player.first) != std::end(m_partyMembers))
+        {
+            auto stateItor = m_memberStates.find(player.first);
+            if (stateItor != std::end(m_memberStates))
+            {
+                const auto& state = stateItor->second;
+
+                ImGui::SameLine(100);
+                ImGui::Text("%.0f/%.0f (%.0f, %.0f, %.0f)", state.Health, state.MaxHealth, state.Position.x, state.Position.y, state.Position.z);
+            }
+
             continue;
+        }
 
         ImGui::SameLine(100);
 
@@ -17,6 +17,7 @@
 
 #include <Messages/RequestQuestUpdate.h>
 #include <Messages/NotifyQuestUpdate.h>
+#include <Messages/NotifyQuestUpdateBatch.h>
 
 #define QUEST_DEBUG 0
 
@@ -36,6 +37,7 @@ QuestService::QuestService(World& aWorld, entt::dispatcher& aDispatcher, ImguiSe
     m_joinedConnection = aDispatcher.sink<ConnectedEvent>().connect<&QuestService::OnConnected>(this);
     m_leftConnection = aDispatcher.sink<DisconnectedEvent>().connect<&QuestService::OnDisconnected>(this);
     m_questUpdateConnection = aDispatcher.sink<NotifyQuestUpdate>().connect<&QuestService::OnQuestUpdate>(this);
+    m_questUpdateBatchConnection = aDispatcher.sink<NotifyQuestUpdateBatch>().connect<&QuestService::OnQuestUpdateBatch>(this);
 
 #if QUEST_DEBUG
     m_drawConnection = aImguiService.OnDraw.connect<&QuestService::OnDraw>(this);
@@ -96,6 +98,12 @@ void QuestService::OnQuestUpdate(const NotifyQuestUpdate& aUpdate) noexcept
         spdlog::error("Failed to update the client quest state");
 }
 
+void QuestService::OnQuestUpdateBatch(const NotifyQuestUpdateBatch& acBatch) noexcept
+{
+    for (const auto& update : acBatch.Updates)
+        OnQuestUpdate(update);
+}
+
 TESQuest* QuestService::SetQuestStage(uint32_t aFormId, uint16_t aStage)
 {
     auto* pQuest = RTTI_CAST(TESForm::GetById(aFormId), TESForm, TESQuest);
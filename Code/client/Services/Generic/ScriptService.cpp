@@ -16,6 +16,7 @@
 
 #include <Events/EventDispatcher.h>
 #include <Messages/ClientRpcCalls.h>
+#include <Messages/ServerScriptUpdate.h>
 
 #include <imgui.h>
 
@@ -29,6 +30,7 @@ ScriptService::ScriptService(World& aWorld, entt::dispatcher& aDispatcher, Imgui
     m_scriptsConnection = m_dispatcher.sink<Scripts>().connect<&ScriptService::OnScripts>(this);
     m_replicatedInitConnection = m_dispatcher.sink<FullObjects>().connect < &ScriptService::OnNetObjectsInitalize >(this);
     m_replicatedUpdateConnection = m_dispatcher.sink<Objects>().connect < &ScriptService::OnNetObjectsUpdate >(this);
+    m_scriptUpdateConnection = m_dispatcher.sink<ServerScriptUpdate>().connect<&ScriptService::OnScriptUpdate>(this);
 
     m_connectedConnection = m_dispatcher.sink<ConnectedEvent>().connect<&ScriptService::OnConnected>(this);
     m_disconnectedConnection = m_dispatcher.sink<DisconnectedEvent>().connect<&ScriptService::OnDisconnected>(this);
@@ -108,6 +110,21 @@ void ScriptService::OnNetObjectsUpdate(const Objects& acNetObjects) noexcept
     GetNetState()->ApplyDifferentialSnapshot(reader);
 }
 
+void ScriptService::OnScriptUpdate(const ServerScriptUpdate& acMessage) noexcept
+{
+    if (acMessage.Reload)
+    {
+        // The server hot reloaded its scripts, swap definitions and objects without dropping the connection
+        Reset();
+        OnScripts(acMessage.Definitions);
+        OnNetObjectsInitalize(acMessage.ReplicatedObjects);
+    }
+    else
+    {
+        OnNetObjectsUpdate(acMessage.Data);
+    }
+}
+
 void ScriptService::OnConnected(const ConnectedEvent&) noexcept
 {
 }
@@ -26,8 +26,11 @@
 #include <Messages/ServerMessageFactory.h>
 #include <Messages/AssignCharacterResponse.h>
 #include <Messages/ServerReferencesMoveRequest.h>
+#include <Messages/ServerScriptUpdate.h>
 #include <Messages/EnterCellRequest.h>
 #include <Messages/CharacterSpawnRequest.h>
+#include <Messages/NotifyCharacterSpawnBatch.h>
+#include <Messages/ServerMessageBundle.h>
 #include <Messages/NotifyInventoryChanges.h>
 #include <Messages/NotifyFactionsChanges.h>
 #include <Messages/ServerTimeSettings.h>
@@ -41,6 +44,10 @@
 #include <Messages/NotifyActorMaxValueChanges.h>
 #include <Messages/NotifyHealthChangeBroadcast.h>
 #include <Messages/NotifySpawnData.h>
+#include <Messages/NotifyPartyMemberStates.h>
+#include <Messages/NotifyPlayerJoined.h>
+#include <Messages/NotifyPlayerLeft.h>
+#include <Messages/NotifyQuestUpdateBatch.h>
 
 #define TRANSPORT_DISPATCH(packetName) \
 case k##packetName: \
@@ -83,7 +90,7 @@ bool TransportService::Send(const ClientMessage& acMessage) const noexcept
         acMessage.Serialize(writer);
         TiltedPhoques::PacketView packet(reinterpret_cast<char*>(buffer.GetWriteData()), writer.Size());
 
-        Client::Send(&packet);
+        Client::Send(&packet, acMessage.GetDeliveryClass() == kUnreliableSequenced ? TiltedPhoques::kUnreliable : TiltedPhoques::kReliable);
 
         return true;
     }
@@ -106,6 +113,14 @@ void TransportService::OnConsume(const void* apData, uint32_t aSize)
 
     switch (pMessage->GetOpcode())
     {
+    case kServerMessageBundle:
+    {
+        // The server coalesces a tick worth of messages, each one is handled as if it arrived on its own
+        const auto pBundle = TiltedPhoques::CastUnique<ServerMessageBundle>(std::move(pMessage));
+        pBundle->Visit([this](const uint8_t* apData, size_t aSize) { OnConsume(apData, static_cast<uint32_t>(aSize)); });
+    }
+    break;
+
     case kAuthenticationResponse:
     {
         const auto pRealMessage = TiltedPhoques::CastUnique<AuthenticationResponse>(std::move(pMessage));
@@ -115,6 +130,7 @@ void TransportService::OnConsume(const void* apData, uint32_t aSize)
 
     TRANSPORT_DISPATCH(AssignCharacterResponse);
     TRANSPORT_DISPATCH(ServerReferencesMoveRequest);
+    TRANSPORT_DISPATCH(ServerScriptUpdate);
     TRANSPORT_DISPATCH(ServerTimeSettings);
     TRANSPORT_DISPATCH(CharacterSpawnRequest);
     TRANSPORT_DISPATCH(NotifyInventoryChanges);
@@ -129,6 +145,11 @@ void TransportService::OnConsume(const void* apData, uint32_t aSize)
     TRANSPORT_DISPATCH(NotifyActorMaxValueChanges);
     TRANSPORT_DISPATCH(NotifyHealthChangeBroadcast);
     TRANSPORT_DISPATCH(NotifySpawnData);
+    TRANSPORT_DISPATCH(NotifyCharacterSpawnBatch);
+    TRANSPORT_DISPATCH(NotifyPartyMemberStates);
+    TRANSPORT_DISPATCH(NotifyPlayerJoined);
+    TRANSPORT_DISPATCH(NotifyPlayerLeft);
+    TRANSPORT_DISPATCH(NotifyQuestUpdateBatch);
 
     default:
         spdlog::error("Client message opcode {} from server has no handler", pMessage->GetOpcode());
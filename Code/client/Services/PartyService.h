@@ -1,8 +1,12 @@
 #pragma once
 
+#include <Messages/NotifyPartyMemberStates.h>
+
 struct ImguiService;
 struct TransportService;
 struct NotifyPlayerList;
+struct NotifyPlayerJoined;
+struct NotifyPlayerLeft;
 struct NotifyPartyInfo;
 struct NotifyPartyInvite;
 struct UpdateEvent;
@@ -18,15 +22,20 @@ protected:
 
     void OnUpdate(const UpdateEvent& acPlayerList) noexcept;
     void OnPlayerList(const NotifyPlayerList& acPlayerList) noexcept;
+    void OnPlayerJoined(const NotifyPlayerJoined& acPlayerJoined) noexcept;
+    void OnPlayerLeft(const NotifyPlayerLeft& acPlayerLeft) noexcept;
     void OnPartyInfo(const NotifyPartyInfo& acPartyInfo) noexcept;
     void OnPartyInvite(const NotifyPartyInvite& acPartyInvite) noexcept;
+    void OnPartyMemberStates(const NotifyPartyMemberStates& acMemberStates) noexcept;
 
 private:
     void OnDraw() noexcept;
 
     Map<uint32_t, String> m_players;
+    uint32_t m_playerListVersion{0};
     Vector<uint32_t> m_partyMembers;
     Map<uint32_t, uint64_t> m_invitations;
+    Map<uint32_t, NotifyPartyMemberStates::MemberState> m_memberStates;
     uint64_t m_nextUpdate{0};
 
     TransportService& m_transportService;
@@ -34,6 +43,9 @@ private:
     entt::scoped_connection m_drawConnection;
     entt::scoped_connection m_updateConnection;
     entt::scoped_connection m_playerListConnection;
+    entt::scoped_connection m_playerJoinedConnection;
+    entt::scoped_connection m_playerLeftConnection;
     entt::scoped_connection m_partyInfoConnection;
     entt::scoped_connection m_partyInviteConnection;
+    entt::scoped_connection m_partyMemberStatesConnection;
 };
@@ -9,6 +9,7 @@ struct QuestInitHandler;
 struct QuestStageHandler;
 struct QuestStartStopHandler;
 struct NotifyQuestUpdate;
+struct NotifyQuestUpdateBatch;
 
 struct TESQuest;
 
@@ -34,6 +35,7 @@ private:
     void OnDisconnected(const DisconnectedEvent&) noexcept;
     void OnDraw() noexcept;
     void OnQuestUpdate(const NotifyQuestUpdate&) noexcept;
+    void OnQuestUpdateBatch(const NotifyQuestUpdateBatch&) noexcept;
 
     TESQuest* SetQuestStage(uint32_t aformId, uint16_t aStage);
     bool StopQuest(uint32_t aformId);
@@ -42,6 +44,7 @@ private:
     entt::scoped_connection m_leftConnection;
     entt::scoped_connection m_drawConnection;
     entt::scoped_connection m_questUpdateConnection;
+    entt::scoped_connection m_questUpdateBatchConnection;
 
     World& m_world;
 };
@@ -15,6 +15,7 @@ struct World;
 struct UpdateEvent;
 struct ImguiService;
 struct GameEventHandler;
+struct ServerScriptUpdate;
 
 struct ScriptService : ScriptStore
 {
@@ -32,6 +33,7 @@ protected:
     void OnScripts(const Scripts& acScripts) noexcept;
     void OnNetObjectsInitalize(const FullObjects& acNetObjects) noexcept;
     void OnNetObjectsUpdate(const Objects& acNetObjects) noexcept;
+    void OnScriptUpdate(const ServerScriptUpdate& acMessage) noexcept;
     void OnConnected(const ConnectedEvent&) noexcept;
     void OnDisconnected(const DisconnectedEvent&) noexcept;
     void DisplayNetObject(NetObject* apObject);
@@ -53,6 +55,7 @@ private:
     entt::scoped_connection m_scriptsConnection;
     entt::scoped_connection m_replicatedInitConnection;
     entt::scoped_connection m_replicatedUpdateConnection;
+    entt::scoped_connection m_scriptUpdateConnection;
     entt::scoped_connection m_drawImGuiConnection;
 
     entt::scoped_connection m_connectedConnection;
@@ -0,0 +1,100 @@
+#include <JobPool.h>
+
+JobPool::JobPool(size_t aThreadCount) noexcept
+{
+    m_threads.reserve(aThreadCount);
+
+    for (size_t i = 0; i < aThreadCount; ++i)
+        m_threads.emplace_back(&JobPool::Run, this);
+}
+
+JobPool::~JobPool() noexcept
+{
+    {
+        std::scoped_lock _{ m_lock };
+        m_running = false;
+    }
+
+    m_wakeup.notify_all();
+
+    for (auto& thread : m_threads)
+        thread.join();
+}
+
+void JobPool::ParallelFor(size_t aCount, const std::function<void(size_t)>& acTask) noexcept
+{
+    if (aCount == 0)
+        return;
+
+    // Not worth waking anyone up
+    if (m_threads.empty() || aCount == 1)
+    {
+        for (size_t i = 0; i < aCount; ++i)
+            acTask(i);
+
+        return;
+    }
+
+    Job job;
+    job.pTask = &acTask;
+    job.Count = aCount;
+    job.Remaining = aCount;
+
+    {
+        std::scoped_lock _{ m_lock };
+        m_pJob = &job;
+        ++m_generation;
+    }
+
+    m_wakeup.notify_all();
+
+    Work(job);
+
+    // The job lives on our stack, wait until no worker holds on to it anymore
+    std::unique_lock lock{ m_lock };
+    m_done.wait(lock, [&job] { return job.Remaining == 0 && job.Users == 0; });
+
+    m_pJob = nullptr;
+}
+
+void JobPool::Run() noexcept
+{
+    uint64_t generation = 0;
+
+    while (true)
+    {
+        Job* pJob = nullptr;
+
+        {
+            std::unique_lock lock{ m_lock };
+            m_wakeup.wait(lock, [this, generation] { return !m_running || (m_pJob && m_generation != generation); });
+
+            if (!m_running)
+                return;
+
+            generation = m_generation;
+            pJob = m_pJob;
+            ++pJob->Users;
+        }
+
+        Work(*pJob);
+
+        {
+            std::scoped_lock _{ m_lock };
+            --pJob->Users;
+        }
+
+        m_done.notify_all();
+    }
+}
+
+void JobPool::Work(Job& aJob) noexcept
+{
+    // Workers grab the next index as they free up, uneven tasks balance out without explicit stealing
+    for (auto i = aJob.Next.fetch_add(1); i < aJob.Count; i = aJob.Next.fetch_add(1))
+    {
+        (*aJob.pTask)(i);
+
+        aJob.Remaining.fetch_sub(1);
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of threads running fan-out jobs, the calling thread takes part in every job so a pool without threads is valid
+struct JobPool
+{
+    explicit JobPool(size_t aThreadCount) noexcept;
+    ~JobPool() noexcept;
+
+    JobPool(const JobPool&) = delete;
+    JobPool& operator=(const JobPool&) = delete;
+
+    [[nodiscard]] size_t GetThreadCount() const noexcept { return m_threads.size(); }
+
+    // Runs acTask(i) for every i in [0, aCount) and returns once all of them completed
+    void ParallelFor(size_t aCount, const std::function<void(size_t)>& acTask) noexcept;
+
+private:
+
+    struct Job
+    {
+        const std::function<void(size_t)>* pTask;
+        size_t Count;
+        std::atomic<size_t> Next{ 0 };
+        std::atomic<size_t> Remaining{ 0 };
+        size_t Users{ 0 };
+    };
+
+    void Run() noexcept;
+    void Work(Job& aJob) noexcept;
+
+    std::vector<std::thread> m_threads;
+    std::mutex m_lock;
+    std::condition_variable m_wakeup;
+    std::condition_variable m_done;
+
+    // Guarded by m_lock
+    Job* m_pJob{ nullptr };
+    uint64_t m_generation{ 0 };
+    bool m_running{ true };
+};
@@ -0,0 +1,93 @@
+#include <MovementHistory.h>
+
+#include <glm/common.hpp>
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+float LerpAngle(float aFrom, float aTo, float aAlpha) noexcept
+{
+    // Go the short way around, rotations wrap at 2 pi
+    const auto cDelta = std::remainder(aTo - aFrom, glm::two_pi<float>());
+
+    return aFrom + cDelta * aAlpha;
+}
+}
+
+MovementHistory::MovementHistory(uint32_t aCapacity) noexcept
+    : m_ticks(std::max(aCapacity, 1u))
+    , m_positions(m_ticks.size())
+    , m_rotations(m_ticks.size())
+{
+}
+
+void MovementHistory::Record(uint64_t aTick, const glm::vec3& acPosition, const glm::vec3& acRotation) noexcept
+{
+    if (m_size > 0 && aTick <= m_ticks[GetSlot(m_size - 1)])
+        return;
+
+    const auto cCapacity = GetCapacity();
+
+    uint32_t slot;
+    if (m_size < cCapacity)
+    {
+        slot = GetSlot(m_size);
+        ++m_size;
+    }
+    else
+    {
+        // Full, overwrite the oldest sample
+        slot = m_start;
+        m_start = (m_start + 1) % cCapacity;
+    }
+
+    m_ticks[slot] = aTick;
+    m_positions[slot] = acPosition;
+    m_rotations[slot] = acRotation;
+}
+
+bool MovementHistory::Sample(uint64_t aTick, glm::vec3& aPosition, glm::vec3& aRotation) const noexcept
+{
+    if (m_size == 0 || aTick < m_ticks[m_start])
+        return false;
+
+    const auto cLatest = GetSlot(m_size - 1);
+    if (aTick >= m_ticks[cLatest])
+    {
+        aPosition = m_positions[cLatest];
+        aRotation = m_rotations[cLatest];
+        return true;
+    }
+
+    // Find the first sample after aTick, the one before it is at or before aTick
+    uint32_t low = 1;
+    uint32_t high = m_size - 1;
+    while (low < high)
+    {
+        const auto cMiddle = low + (high - low) / 2;
+        if (m_ticks[GetSlot(cMiddle)] <= aTick)
+            low = cMiddle + 1;
+        else
+            high = cMiddle;
+    }
+
+    const auto cFrom = GetSlot(low - 1);
+    const auto cTo = GetSlot(low);
+
+    const auto cAlpha = static_cast<float>(aTick - m_ticks[cFrom]) / static_cast<float>(m_ticks[cTo] - m_ticks[cFrom]);
+
+    aPosition = glm::mix(m_positions[cFrom], m_positions[cTo], cAlpha);
+    aRotation.x = LerpAngle(m_rotations[cFrom].x, m_rotations[cTo].x, cAlpha);
+    aRotation.y = LerpAngle(m_rotations[cFrom].y, m_rotations[cTo].y, cAlpha);
+    aRotation.z = LerpAngle(m_rotations[cFrom].z, m_rotations[cTo].z, cAlpha);
+
+    return true;
+}
+
+uint32_t MovementHistory::GetSlot(uint32_t aIndex) const noexcept
+{
+    return (m_start + aIndex) % GetCapacity();
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <glm/vec3.hpp>
+
+#include <cstdint>
+#include <vector>
+
+// Ring of the last few movement samples of an actor, used to find out where it was at a given tick
+struct MovementHistory
+{
+    explicit MovementHistory(uint32_t aCapacity) noexcept;
+
+    // Samples must arrive in tick order, anything not newer than the latest sample is dropped
+    void Record(uint64_t aTick, const glm::vec3& acPosition, const glm::vec3& acRotation) noexcept;
+
+    // Interpolates between the two samples surrounding aTick, ticks past the latest sample return the latest one
+    // Fails when the history is empty or aTick is older than anything still recorded
+    [[nodiscard]] bool Sample(uint64_t aTick, glm::vec3& aPosition, glm::vec3& aRotation) const noexcept;
+
+    [[nodiscard]] uint32_t GetCapacity() const noexcept { return static_cast<uint32_t>(m_ticks.size()); }
+    [[nodiscard]] uint32_t GetSize() const noexcept { return m_size; }
+
+private:
+
+    [[nodiscard]] uint32_t GetSlot(uint32_t aIndex) const noexcept;
+
+    // Ticks are kept apart from the rest so lookups only walk through them
+    std::vector<uint64_t> m_ticks;
+    std::vector<glm::vec3> m_positions;
+    std::vector<glm::vec3> m_rotations;
+
+    // Slot of the oldest sample
+    uint32_t m_start{ 0 };
+    uint32_t m_size{ 0 };
+};
@@ -1,11 +1,13 @@
-
 #include <Structs/TimeModel.h>
 
+#include <algorithm>
+#include <cmath>
+
 const int cDayLengthArray[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
 
-int TimeModel::GetNumerOfDaysByMonthIndex(int aIndex)
+int TimeModel::GetNumerOfDaysByMonthIndex(int aIndex) noexcept
 {
-    if (aIndex < 12)
+    if (aIndex >= 0 && aIndex < 12)
     {
         return cDayLengthArray[aIndex];
     }
@@ -13,31 +15,72 @@ int TimeModel::GetNumerOfDaysByMonthIndex(int aIndex)
     return 0;
 }
 
-void TimeModel::Update(uint64_t aDelta)
+uint64_t TimeModel::GetGameTime(uint64_t aTick) const noexcept
+{
+    // Ticks before the epoch happen when a client's clock is slightly behind, hold the time instead of going back
+    if (aTick <= EpochTick)
+        return GameTime;
+
+    return GameTime + (aTick - EpochTick) * Rate / kRateUnit;
+}
+
+uint64_t TimeModel::GetTimeOfDay(uint64_t aTick) const noexcept
+{
+    return GetGameTime(aTick) % kDayLength;
+}
+
+float TimeModel::GetHour(uint64_t aTick) const noexcept
+{
+    return static_cast<float>(static_cast<double>(GetTimeOfDay(aTick)) / static_cast<double>(kHourLength));
+}
+
+TimeModel::Date TimeModel::GetDate(uint64_t aTick) const noexcept
 {
-    float deltaSeconds = static_cast<float>(aDelta) / 1000.f;
-    Time += (deltaSeconds * (TimeScale * 0.00027777778f));
+    return ToDate(GetGameTime(aTick));
+}
+
+float TimeModel::GetTimeScale() const noexcept
+{
+    return static_cast<float>(Rate) / static_cast<float>(kRateUnit);
+}
 
-    if (Time > 24.f)
+void TimeModel::Rebase(uint64_t aTick) noexcept
+{
+    GameTime = GetGameTime(aTick);
+    EpochTick = aTick;
+}
+
+void TimeModel::SetTimeScale(float aTimeScale, uint64_t aTick) noexcept
+{
+    Rebase(aTick);
+    Rate = static_cast<uint32_t>(std::lround(std::max(aTimeScale, 0.f) * kRateUnit));
+}
+
+void TimeModel::SetTimeOfDay(uint64_t aTimeOfDay, uint64_t aTick) noexcept
+{
+    Rebase(aTick);
+    GameTime = GameTime - GameTime % kDayLength + aTimeOfDay;
+}
+
+TimeModel::Date TimeModel::ToDate(uint64_t aGameTime) noexcept
+{
+    const auto cDays = aGameTime / kDayLength;
+
+    Date date{};
+    date.Year = static_cast<int>(cDays / kDaysPerYear) + 1;
+
+    auto dayOfYear = static_cast<int>(cDays % kDaysPerYear);
+
+    date.Month = 0;
+    while (dayOfYear >= cDayLengthArray[date.Month])
     {
-        int maxDays = GetNumerOfDaysByMonthIndex(Month);
-
-        while (Time > 24.f)
-        {
-            Time = Time + -24.f;
-            Day++;
-        }
-
-        if (Day > maxDays)
-        {
-            Month++;
-            Day = Day - maxDays;
-
-            if (Month > 12)
-            {
-                Month = Month + -12;
-                Year++;
-            }
-        }
+        dayOfYear -= cDayLengthArray[date.Month];
+        date.Month++;
     }
+
+    // Both are one based like the game's globals
+    date.Month++;
+    date.Day = dayOfYear + 1;
+
+    return date;
 }
@@ -2,15 +2,51 @@
 
 #include <cstdint>
 
+// Game time is an integer count of game milliseconds captured at a server tick, the current time is always
+// extrapolated from that epoch with the rate so it never accumulates rounding errors
 struct TimeModel
 {
+    static constexpr uint64_t kMinuteLength = 60 * 1000;
+    static constexpr uint64_t kHourLength = 60 * kMinuteLength;
+    static constexpr uint64_t kDayLength = 24 * kHourLength;
+    static constexpr uint32_t kDaysPerYear = 365;
+    // Rate is stored in thousandths of the time scale
+    static constexpr uint32_t kRateUnit = 1000;
+
+    struct Date
+    {
+        int Year;
+        int Month;
+        int Day;
+    };
+
     // Default time: 01/01/01 at 12:00
-    float TimeScale = 20.f;
-    float Time = 12.f;
-    int Year = 1;
-    int Month = 1;
-    int Day = 1;
-
-    void Update(uint64_t aDelta);
-    [[nodiscard]] static int GetNumerOfDaysByMonthIndex(int index);
+    uint64_t GameTime = 12 * kHourLength;
+    uint64_t EpochTick = 0;
+    uint32_t Rate = 20 * kRateUnit;
+
+    [[nodiscard]] uint64_t GetGameTime(uint64_t aTick) const noexcept;
+    [[nodiscard]] uint64_t GetTimeOfDay(uint64_t aTick) const noexcept;
+    [[nodiscard]] float GetHour(uint64_t aTick) const noexcept;
+    [[nodiscard]] Date GetDate(uint64_t aTick) const noexcept;
+    [[nodiscard]] float GetTimeScale() const noexcept;
+
+    // Moves the epoch to aTick without changing the time
+    void Rebase(uint64_t aTick) noexcept;
+    void SetTimeScale(float aTimeScale, uint64_t aTick) noexcept;
+    // Keeps the current day
+    void SetTimeOfDay(uint64_t aTimeOfDay, uint64_t aTick) noexcept;
+
+    [[nodiscard]] static Date ToDate(uint64_t aGameTime) noexcept;
+    [[nodiscard]] static int GetNumerOfDaysByMonthIndex(int aIndex) noexcept;
+
+    bool operator==(const TimeModel& acRhs) const noexcept
+    {
+        return GameTime == acRhs.GameTime && EpochTick == acRhs.EpochTick && Rate == acRhs.Rate;
+    }
+
+    bool operator!=(const TimeModel& acRhs) const noexcept
+    {
+        return !this->operator==(acRhs);
+    }
 };
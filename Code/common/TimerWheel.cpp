@@ -0,0 +1,204 @@
+#include <TimerWheel.h>
+
+#include <algorithm>
+
+TimerWheel::TimerWheel(uint64_t aStartTick) noexcept
+    : m_current(aStartTick)
+    , m_target(aStartTick)
+{
+    for (auto& level : m_slots)
+        level.fill(kNone);
+}
+
+TimerWheel::TimerId TimerWheel::Schedule(uint64_t aDelay, Callback aCallback) noexcept
+{
+    const auto cIndex = Allocate();
+
+    auto& timer = m_timers[cIndex];
+    timer.Expiry = m_current + std::max<uint64_t>(aDelay, 1);
+    timer.Interval = 0;
+    timer.Function = std::move(aCallback);
+
+    Insert(cIndex);
+
+    return (static_cast<uint64_t>(timer.Generation) << 32) | cIndex;
+}
+
+TimerWheel::TimerId TimerWheel::ScheduleRepeating(uint64_t aInterval, Callback aCallback) noexcept
+{
+    const auto cId = Schedule(aInterval, std::move(aCallback));
+    m_timers[cId & 0xFFFFFFFF].Interval = std::max<uint64_t>(aInterval, 1);
+
+    return cId;
+}
+
+void TimerWheel::Cancel(TimerId aId) noexcept
+{
+    auto* pTimer = Find(aId);
+    if (!pTimer)
+        return;
+
+    const auto cIndex = static_cast<uint32_t>(aId & 0xFFFFFFFF);
+
+    // It isn't linked anywhere while it runs, Advance releases it once the callback returns
+    if (cIndex == m_firing)
+    {
+        pTimer->Cancelled = true;
+        return;
+    }
+
+    Unlink(cIndex);
+    Release(cIndex);
+}
+
+void TimerWheel::Advance(uint64_t aTick) noexcept
+{
+    m_target = std::max(m_current, aTick);
+
+    while (m_current < aTick)
+    {
+        // Nothing can be due, new timers are placed relative to wherever the wheel stands
+        if (m_count == 0)
+        {
+            m_current = aTick;
+            return;
+        }
+
+        ++m_current;
+
+        // Bring the next block of every coarser level down before firing, a lower level wrapping is what makes it due
+        for (uint32_t level = 1; level < kLevelCount; ++level)
+        {
+            if ((m_current & ((uint64_t(1) << (level * kSlotBits)) - 1)) != 0)
+                break;
+
+            Cascade(level);
+        }
+
+        auto& head = m_slots[0][m_current & kSlotMask];
+        while (head != kNone)
+        {
+            const auto cIndex = head;
+            Unlink(cIndex);
+
+            // Callbacks can schedule timers and grow the pool, so never hold on to the timer across the call
+            auto function = std::move(m_timers[cIndex].Function);
+
+            m_firing = cIndex;
+            function();
+            m_firing = kNone;
+
+            auto& timer = m_timers[cIndex];
+            if (timer.Interval != 0 && !timer.Cancelled)
+            {
+                timer.Function = std::move(function);
+                timer.Expiry = m_target + timer.Interval;
+                Insert(cIndex);
+            }
+            else
+            {
+                Release(cIndex);
+            }
+        }
+    }
+}
+
+uint32_t TimerWheel::Allocate() noexcept
+{
+    ++m_count;
+
+    if (!m_free.empty())
+    {
+        const auto cIndex = m_free.back();
+        m_free.pop_back();
+        return cIndex;
+    }
+
+    m_timers.emplace_back();
+    return static_cast<uint32_t>(m_timers.size() - 1);
+}
+
+void TimerWheel::Release(uint32_t aIndex) noexcept
+{
+    auto& timer = m_timers[aIndex];
+    timer.Function = nullptr;
+    timer.Cancelled = false;
+    // Ids handed out for this slot are stale from now on
+    ++timer.Generation;
+
+    m_free.push_back(aIndex);
+    --m_count;
+}
+
+void TimerWheel::Insert(uint32_t aIndex) noexcept
+{
+    auto& timer = m_timers[aIndex];
+
+    const auto cDelta = timer.Expiry > m_current ? timer.Expiry - m_current : 0;
+
+    uint32_t level = 0;
+    while (level + 1 < kLevelCount && cDelta >= (uint64_t(1) << ((level + 1) * kSlotBits)))
+        ++level;
+
+    // Past the last level it sits in the furthest slot and gets placed again when that slot cascades
+    const auto cMaxDelta = (uint64_t(1) << (kLevelCount * kSlotBits)) - 1;
+    const auto cTarget = m_current + std::min(cDelta, cMaxDelta);
+
+    auto& head = m_slots[level][(cTarget >> (level * kSlotBits)) & kSlotMask];
+
+    timer.pHead = &head;
+    timer.Previous = kNone;
+    timer.Next = head;
+
+    if (head != kNone)
+        m_timers[head].Previous = aIndex;
+
+    head = aIndex;
+}
+
+void TimerWheel::Unlink(uint32_t aIndex) noexcept
+{
+    auto& timer = m_timers[aIndex];
+
+    if (timer.Previous != kNone)
+        m_timers[timer.Previous].Next = timer.Next;
+    else
+        *timer.pHead = timer.Next;
+
+    if (timer.Next != kNone)
+        m_timers[timer.Next].Previous = timer.Previous;
+
+    timer.Previous = kNone;
+    timer.Next = kNone;
+    timer.pHead = nullptr;
+}
+
+void TimerWheel::Cascade(uint32_t aLevel) noexcept
+{
+    auto& head = m_slots[aLevel][(m_current >> (aLevel * kSlotBits)) & kSlotMask];
+
+    auto index = head;
+    head = kNone;
+
+    while (index != kNone)
+    {
+        const auto cNext = m_timers[index].Next;
+        Insert(index);
+        index = cNext;
+    }
+}
+
+TimerWheel::Timer* TimerWheel::Find(TimerId aId) noexcept
+{
+    const auto cIndex = static_cast<uint32_t>(aId & 0xFFFFFFFF);
+    const auto cGeneration = static_cast<uint32_t>(aId >> 32);
+
+    if (cIndex >= m_timers.size())
+        return nullptr;
+
+    auto& timer = m_timers[cIndex];
+    if (timer.Generation != cGeneration || (timer.pHead == nullptr && cIndex != m_firing))
+        return nullptr;
+
+    return &timer;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Hierarchical timing wheel counting abstract ticks, scheduling and cancelling are O(1) and advancing only touches
+// the slots that are due plus a cascade of the coarser levels every 64 ticks
+struct TimerWheel
+{
+    using TimerId = uint64_t;
+    using Callback = std::function<void()>;
+
+    static constexpr TimerId kInvalidTimer = 0;
+
+    explicit TimerWheel(uint64_t aStartTick = 0) noexcept;
+    ~TimerWheel() noexcept = default;
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    // Fires acCallback aDelay ticks from now, a delay of 0 fires on the next tick
+    TimerId Schedule(uint64_t aDelay, Callback aCallback) noexcept;
+    // Fires acCallback every aInterval ticks until cancelled, at most once per Advance so a late caller doesn't get bursts
+    TimerId ScheduleRepeating(uint64_t aInterval, Callback aCallback) noexcept;
+    // Safe to call with stale ids, from inside callbacks and on the timer that is currently firing
+    void Cancel(TimerId aId) noexcept;
+
+    // Fires everything due up to and including aTick, one tick at a time
+    void Advance(uint64_t aTick) noexcept;
+
+    [[nodiscard]] uint64_t GetCurrentTick() const noexcept { return m_current; }
+    [[nodiscard]] size_t GetCount() const noexcept { return m_count; }
+
+private:
+
+    static constexpr uint32_t kSlotBits = 6;
+    static constexpr uint32_t kSlotCount = 1 << kSlotBits;
+    static constexpr uint32_t kSlotMask = kSlotCount - 1;
+    static constexpr uint32_t kLevelCount = 4;
+    static constexpr uint32_t kNone = UINT32_MAX;
+
+    struct Timer
+    {
+        uint64_t Expiry;
+        uint64_t Interval;
+        Callback Function;
+        uint32_t Generation{ 1 };
+        uint32_t Previous{ kNone };
+        uint32_t Next{ kNone };
+        uint32_t* pHead{ nullptr };
+        bool Cancelled{ false };
+    };
+
+    [[nodiscard]] uint32_t Allocate() noexcept;
+    void Release(uint32_t aIndex) noexcept;
+    void Insert(uint32_t aIndex) noexcept;
+    void Unlink(uint32_t aIndex) noexcept;
+    void Cascade(uint32_t aLevel) noexcept;
+    [[nodiscard]] Timer* Find(TimerId aId) noexcept;
+
+    std::vector<Timer> m_timers;
+    std::vector<uint32_t> m_free;
+    std::array<std::array<uint32_t, kSlotCount>, kLevelCount> m_slots;
+    uint64_t m_current;
+    uint64_t m_target;
+    size_t m_count{ 0 };
+    uint32_t m_firing{ kNone };
+};
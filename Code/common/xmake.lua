@@ -5,4 +5,4 @@ target("Common")
     add_includedirs(".", "../", {public = true})
     add_headerfiles("**.h", {prefixdir = "Common"})
     add_files("**.cpp")
-    add_packages("tiltedcore", "hopscotch-map")
+    add_packages("tiltedcore", "hopscotch-map", "glm")
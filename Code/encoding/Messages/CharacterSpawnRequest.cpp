@@ -7,13 +7,34 @@ void CharacterSpawnRequest::SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter)
     BaseId.Serialize(aWriter);
     Position.Serialize(aWriter);
     Rotation.Serialize(aWriter);
-    aWriter.WriteBits(ChangeFlags, 32);
-    Serialization::WriteString(aWriter, AppearanceBuffer);
-    InventoryContent.Serialize(aWriter);
-    FactionsContent.Serialize(aWriter);
     LatestAction.GenerateDifferential(ActionEvent{}, aWriter);
-    FaceTints.Serialize(aWriter);
-    InitialActorValues.Serialize(aWriter);
+
+    // The state is length prefixed bytes so an encoded copy can be written at any bit position
+    if (EncodedState)
+    {
+        Serialization::WriteVarInt(aWriter, EncodedState->size());
+        aWriter.WriteBytes(EncodedState->data(), EncodedState->size());
+        return;
+    }
+
+    TiltedPhoques::Buffer buffer(1 << 16);
+    TiltedPhoques::Buffer::Writer writer(&buffer);
+    SerializeState(writer, ChangeFlags, AppearanceBuffer, InventoryContent, FactionsContent, FaceTints, InitialActorValues);
+
+    Serialization::WriteVarInt(aWriter, writer.Size());
+    aWriter.WriteBytes(buffer.GetWriteData(), writer.Size());
+}
+
+void CharacterSpawnRequest::SerializeState(TiltedPhoques::Buffer::Writer& aWriter, uint32_t aChangeFlags, const String& acAppearanceBuffer,
+                                           const Inventory& acInventory, const Factions& acFactions, const Tints& acFaceTints,
+                                           const ActorValues& acActorValues) noexcept
+{
+    aWriter.WriteBits(aChangeFlags, 32);
+    Serialization::WriteString(aWriter, acAppearanceBuffer);
+    acInventory.Serialize(aWriter);
+    acFactions.Serialize(aWriter);
+    acFaceTints.Serialize(aWriter);
+    acActorValues.Serialize(aWriter);
 }
 
 void CharacterSpawnRequest::DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept
@@ -26,20 +47,33 @@ void CharacterSpawnRequest::DeserializeRaw(TiltedPhoques::Buffer::Reader& aReade
     Position.Deserialize(aReader);
     Rotation.Deserialize(aReader);
 
+    LatestAction = ActionEvent{};
+    LatestAction.ApplyDifferential(aReader);
+
+    // The size comes from the wire, never allocate more than what is actually left in the packet
+    const auto cStateSize = Serialization::ReadVarInt(aReader);
+    const auto cRemaining = aReader.m_pBuffer->GetSize() - aReader.GetBytePosition();
+
+    if (cStateSize == 0 || cStateSize > cRemaining)
+        return;
+
+    TiltedPhoques::Buffer buffer(cStateSize);
+    if (!aReader.ReadBytes(buffer.GetWriteData(), cStateSize))
+        return;
+
+    TiltedPhoques::Buffer::Reader reader(&buffer);
+
     uint64_t dest = 0;
-    aReader.ReadBits(dest, 32);
+    reader.ReadBits(dest, 32);
     ChangeFlags = dest & 0xFFFFFFFF;
 
-    AppearanceBuffer = Serialization::ReadString(aReader);
+    AppearanceBuffer = Serialization::ReadString(reader);
     InventoryContent = {};
-    InventoryContent.Deserialize(aReader);
+    InventoryContent.Deserialize(reader);
 
     FactionsContent = {};
-    FactionsContent.Deserialize(aReader);
-
-    LatestAction = ActionEvent{};
-    LatestAction.ApplyDifferential(aReader);
+    FactionsContent.Deserialize(reader);
 
-    FaceTints.Deserialize(aReader);
-    InitialActorValues.Deserialize(aReader);
+    FaceTints.Deserialize(reader);
+    InitialActorValues.Deserialize(reader);
 }
@@ -10,6 +10,9 @@
 #include <Structs/Rotator2_NetQuantize.h>
 #include <Structs/ActorValues.h>
 
+#include <memory>
+#include <vector>
+
 using TiltedPhoques::String;
 
 struct CharacterSpawnRequest final : ServerMessage
@@ -22,6 +25,11 @@ struct CharacterSpawnRequest final : ServerMessage
     void SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter) const noexcept override;
     void DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept override;
 
+    // Encodes the slow changing part of a spawn on its own so the bytes can be kept and sent through EncodedState
+    static void SerializeState(TiltedPhoques::Buffer::Writer& aWriter, uint32_t aChangeFlags, const String& acAppearanceBuffer,
+                               const Inventory& acInventory, const Factions& acFactions, const Tints& acFaceTints,
+                               const ActorValues& acActorValues) noexcept;
+
     bool operator==(const CharacterSpawnRequest& acRhs) const noexcept
     {
         return
@@ -50,4 +58,7 @@ struct CharacterSpawnRequest final : ServerMessage
     ActionEvent LatestAction{};
     Tints FaceTints{};
     ActorValues InitialActorValues{};
+
+    // When set the state is sent from these bytes and the fields above it are ignored, never set on the receiving end
+    std::shared_ptr<const std::vector<uint8_t>> EncodedState{};
 };
@@ -26,3 +26,14 @@ void ClientReferencesMoveRequest::DeserializeRaw(TiltedPhoques::Buffer::Reader&
         Updates[serverId].Deserialize(aReader);
     }
 }
+
+EDeliveryClass ClientReferencesMoveRequest::GetDeliveryClass() const noexcept
+{
+    for (const auto& [id, update] : Updates)
+    {
+        if (!update.ActionEvents.empty())
+            return kReliableOrdered;
+    }
+
+    return ClientMessage::GetDeliveryClass();
+}
@@ -19,6 +19,9 @@ struct ClientReferencesMoveRequest final : ClientMessage
     void SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter) const noexcept override;
     void DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept override;
 
+    // Action events are not resent by the next update, losing them would desync animations
+    [[nodiscard]] EDeliveryClass GetDeliveryClass() const noexcept override;
+
     bool operator==(const ClientReferencesMoveRequest& acRhs) const noexcept
     {
         return Updates == acRhs.Updates &&
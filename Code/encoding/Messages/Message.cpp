@@ -14,6 +14,11 @@ ClientOpcode ClientMessage::GetOpcode() const noexcept
     return m_opcode;
 }
 
+EDeliveryClass ClientMessage::GetDeliveryClass() const noexcept
+{
+    return GetDefaultDeliveryClass(m_opcode);
+}
+
 void ClientMessage::Serialize(TiltedPhoques::Buffer::Writer& aWriter) const noexcept
 {
     ClientMessage::SerializeRaw(aWriter);
@@ -44,6 +49,11 @@ ServerOpcode ServerMessage::GetOpcode() const noexcept
     return m_opcode;
 }
 
+EDeliveryClass ServerMessage::GetDeliveryClass() const noexcept
+{
+    return GetDefaultDeliveryClass(m_opcode);
+}
+
 void ServerMessage::Serialize(TiltedPhoques::Buffer::Writer& aWriter) const noexcept
 {
     ServerMessage::SerializeRaw(aWriter);
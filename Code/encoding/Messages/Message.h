@@ -26,6 +26,8 @@ struct ClientMessage : TiltedPhoques::AllocatorCompatible
     virtual void DeserializeDifferential(TiltedPhoques::Buffer::Reader& aReader) noexcept;
 
     [[nodiscard]] ClientOpcode GetOpcode() const noexcept;
+    // Defaults to the class declared for the opcode, messages can pick a stricter one depending on their content
+    [[nodiscard]] virtual EDeliveryClass GetDeliveryClass() const noexcept;
 
 private:
     ClientOpcode m_opcode;
@@ -46,6 +48,8 @@ struct ServerMessage : TiltedPhoques::AllocatorCompatible
     virtual void DeserializeDifferential(TiltedPhoques::Buffer::Reader& aReader) noexcept;
 
     [[nodiscard]] ServerOpcode GetOpcode() const noexcept;
+    // Defaults to the class declared for the opcode, messages can pick a stricter one depending on their content
+    [[nodiscard]] virtual EDeliveryClass GetDeliveryClass() const noexcept;
 
 private:
     ServerOpcode m_opcode;
@@ -1,8 +1,7 @@
 #pragma once
 
 #include "Message.h"
-
-using TiltedPhoques::Map;
+#include <Structs/ActorValues.h>
 
 struct NotifyActorMaxValueChanges final : ServerMessage
 {
@@ -21,5 +20,8 @@ struct NotifyActorMaxValueChanges final : ServerMessage
     }
 
     uint32_t Id;
-    Map<uint32_t, float> Values;
+    // What the recipient was sent last, not serialized, only the values that differ from it go on the wire
+    ActorValueList Previous{};
+    // Once received this only holds the values that changed
+    ActorValueList Values{};
 };
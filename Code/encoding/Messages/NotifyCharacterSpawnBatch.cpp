@@ -0,0 +1,20 @@
+#include <Messages/NotifyCharacterSpawnBatch.h>
+
+void NotifyCharacterSpawnBatch::SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter) const noexcept
+{
+    Serialization::WriteVarInt(aWriter, Spawns.size());
+
+    for (const auto& spawn : Spawns)
+        spawn.SerializeRaw(aWriter);
+}
+
+void NotifyCharacterSpawnBatch::DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept
+{
+    ServerMessage::DeserializeRaw(aReader);
+
+    const auto cCount = Serialization::ReadVarInt(aReader) & 0xFFFF;
+
+    Spawns.resize(cCount);
+    for (auto& spawn : Spawns)
+        spawn.DeserializeRaw(aReader);
+}
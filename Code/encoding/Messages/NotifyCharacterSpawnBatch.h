@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Message.h"
+#include <Messages/CharacterSpawnRequest.h>
+
+using TiltedPhoques::Vector;
+
+struct NotifyCharacterSpawnBatch final : ServerMessage
+{
+    NotifyCharacterSpawnBatch()
+        : ServerMessage(kNotifyCharacterSpawnBatch)
+    {
+    }
+
+    void SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter) const noexcept override;
+    void DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept override;
+
+    bool operator==(const NotifyCharacterSpawnBatch& acRhs) const noexcept
+    {
+        return Spawns == acRhs.Spawns &&
+            GetOpcode() == acRhs.GetOpcode();
+    }
+
+    Vector<CharacterSpawnRequest> Spawns{};
+};
@@ -0,0 +1,35 @@
+#include <Messages/NotifyPartyMemberStates.h>
+#include <TiltedCore/Serialization.hpp>
+
+void NotifyPartyMemberStates::SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter) const noexcept
+{
+    aWriter.WriteBits(Members.size() & 0xFF, 8);
+
+    for (const auto& member : Members)
+    {
+        Serialization::WriteVarInt(aWriter, member.PlayerId);
+        member.CellId.Serialize(aWriter);
+        member.Position.Serialize(aWriter);
+        Serialization::WriteFloat(aWriter, member.Health);
+        Serialization::WriteFloat(aWriter, member.MaxHealth);
+    }
+}
+
+void NotifyPartyMemberStates::DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept
+{
+    ServerMessage::DeserializeRaw(aReader);
+
+    uint64_t count = 0;
+    aReader.ReadBits(count, 8);
+
+    Members.resize(count);
+
+    for (auto& member : Members)
+    {
+        member.PlayerId = Serialization::ReadVarInt(aReader) & 0xFFFFFFFF;
+        member.CellId.Deserialize(aReader);
+        member.Position.Deserialize(aReader);
+        member.Health = Serialization::ReadFloat(aReader);
+        member.MaxHealth = Serialization::ReadFloat(aReader);
+    }
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Message.h"
+#include "Structs/GameId.h"
+#include "Structs/Vector3_NetQuantize.h"
+
+using TiltedPhoques::Vector;
+
+struct NotifyPartyMemberStates final : ServerMessage
+{
+    struct MemberState
+    {
+        bool operator==(const MemberState& acRhs) const noexcept
+        {
+            return PlayerId == acRhs.PlayerId &&
+                CellId == acRhs.CellId &&
+                Position == acRhs.Position &&
+                Health == acRhs.Health &&
+                MaxHealth == acRhs.MaxHealth;
+        }
+
+        uint32_t PlayerId{};
+        GameId CellId{};
+        Vector3_NetQuantize Position{};
+        float Health{};
+        float MaxHealth{};
+    };
+
+    NotifyPartyMemberStates() : 
+        ServerMessage(kNotifyPartyMemberStates)
+    {
+    }
+
+    virtual ~NotifyPartyMemberStates() = default;
+
+    void SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter) const noexcept override;
+    void DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept override;
+
+    bool operator==(const NotifyPartyMemberStates& acRhs) const noexcept
+    {
+        return Members == acRhs.Members &&
+            GetOpcode() == acRhs.GetOpcode();
+    }
+
+    Vector<MemberState> Members{};
+};
@@ -0,0 +1,18 @@
+#include <Messages/NotifyPlayerJoined.h>
+#include <TiltedCore/Serialization.hpp>
+
+void NotifyPlayerJoined::SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter) const noexcept
+{
+    Serialization::WriteVarInt(aWriter, Version);
+    Serialization::WriteVarInt(aWriter, PlayerId);
+    Serialization::WriteString(aWriter, Username);
+}
+
+void NotifyPlayerJoined::DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept
+{
+    ServerMessage::DeserializeRaw(aReader);
+
+    Version = Serialization::ReadVarInt(aReader) & 0xFFFFFFFF;
+    PlayerId = Serialization::ReadVarInt(aReader) & 0xFFFFFFFF;
+    Username = Serialization::ReadString(aReader);
+}
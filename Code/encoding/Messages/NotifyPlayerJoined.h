@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Message.h"
+
+using TiltedPhoques::String;
+
+struct NotifyPlayerJoined final : ServerMessage
+{
+    NotifyPlayerJoined() : 
+        ServerMessage(kNotifyPlayerJoined)
+    {
+    }
+
+    virtual ~NotifyPlayerJoined() = default;
+
+    void SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter) const noexcept override;
+    void DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept override;
+
+    bool operator==(const NotifyPlayerJoined& acRhs) const noexcept
+    {
+        return Version == acRhs.Version &&
+            PlayerId == acRhs.PlayerId &&
+            Username == acRhs.Username &&
+            GetOpcode() == acRhs.GetOpcode();
+    }
+
+    uint32_t Version{};
+    uint32_t PlayerId{};
+    String Username{};
+};
@@ -0,0 +1,16 @@
+#include <Messages/NotifyPlayerLeft.h>
+#include <TiltedCore/Serialization.hpp>
+
+void NotifyPlayerLeft::SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter) const noexcept
+{
+    Serialization::WriteVarInt(aWriter, Version);
+    Serialization::WriteVarInt(aWriter, PlayerId);
+}
+
+void NotifyPlayerLeft::DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept
+{
+    ServerMessage::DeserializeRaw(aReader);
+
+    Version = Serialization::ReadVarInt(aReader) & 0xFFFFFFFF;
+    PlayerId = Serialization::ReadVarInt(aReader) & 0xFFFFFFFF;
+}
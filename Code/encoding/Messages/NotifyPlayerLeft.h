@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Message.h"
+
+struct NotifyPlayerLeft final : ServerMessage
+{
+    NotifyPlayerLeft() : 
+        ServerMessage(kNotifyPlayerLeft)
+    {
+    }
+
+    virtual ~NotifyPlayerLeft() = default;
+
+    void SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter) const noexcept override;
+    void DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept override;
+
+    bool operator==(const NotifyPlayerLeft& acRhs) const noexcept
+    {
+        return Version == acRhs.Version &&
+            PlayerId == acRhs.PlayerId &&
+            GetOpcode() == acRhs.GetOpcode();
+    }
+
+    uint32_t Version{};
+    uint32_t PlayerId{};
+};
@@ -19,9 +19,12 @@ struct NotifyPlayerList final : ServerMessage
 
     bool operator==(const NotifyPlayerList& acRhs) const noexcept
     {
-        return Players == acRhs.Players &&
+        return Version == acRhs.Version &&
+            Players == acRhs.Players &&
             GetOpcode() == acRhs.GetOpcode();
     }
 
+    // Deltas with a version up to this one are already part of the list
+    uint32_t Version{};
     Map<uint32_t, String> Players{};
 };
@@ -0,0 +1,20 @@
+#include <Messages/NotifyQuestUpdateBatch.h>
+
+void NotifyQuestUpdateBatch::SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter) const noexcept
+{
+    Serialization::WriteVarInt(aWriter, Updates.size());
+
+    for (const auto& update : Updates)
+        update.SerializeRaw(aWriter);
+}
+
+void NotifyQuestUpdateBatch::DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept
+{
+    ServerMessage::DeserializeRaw(aReader);
+
+    const auto cCount = Serialization::ReadVarInt(aReader) & 0xFFFF;
+
+    Updates.resize(cCount);
+    for (auto& update : Updates)
+        update.DeserializeRaw(aReader);
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Message.h"
+#include <Messages/NotifyQuestUpdate.h>
+
+using TiltedPhoques::Vector;
+
+struct NotifyQuestUpdateBatch final : ServerMessage
+{
+    NotifyQuestUpdateBatch()
+        : ServerMessage(kNotifyQuestUpdateBatch)
+    {
+    }
+
+    void SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter) const noexcept override;
+    void DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept override;
+
+    bool operator==(const NotifyQuestUpdateBatch& acRhs) const noexcept
+    {
+        return Updates == acRhs.Updates &&
+            GetOpcode() == acRhs.GetOpcode();
+    }
+
+    Vector<NotifyQuestUpdate> Updates{};
+};
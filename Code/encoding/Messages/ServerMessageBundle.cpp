@@ -0,0 +1,50 @@
+#include <Messages/ServerMessageBundle.h>
+
+void ServerMessageBundle::SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter) const noexcept
+{
+    Serialization::WriteVarInt(aWriter, Count);
+    Serialization::WriteVarInt(aWriter, Payload.size());
+    aWriter.WriteBytes(Payload.data(), Payload.size());
+}
+
+void ServerMessageBundle::DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept
+{
+    ServerMessage::DeserializeRaw(aReader);
+
+    Count = Serialization::ReadVarInt(aReader) & 0xFFFFFFFF;
+
+    // The size comes from the wire, never allocate more than what is actually left in the packet
+    const auto cSize = Serialization::ReadVarInt(aReader);
+    const auto cRemaining = aReader.m_pBuffer->GetSize() - aReader.GetBytePosition();
+
+    if (cSize > cRemaining)
+    {
+        Clear();
+        return;
+    }
+
+    Payload.resize(cSize);
+    if (!aReader.ReadBytes(Payload.data(), cSize))
+        Clear();
+}
+
+void ServerMessageBundle::Add(const uint8_t* apData, size_t aSize) noexcept
+{
+    auto size = static_cast<uint64_t>(aSize);
+    while (size >= 0x80)
+    {
+        Payload.push_back(static_cast<uint8_t>(size | 0x80));
+        size >>= 7;
+    }
+
+    Payload.push_back(static_cast<uint8_t>(size));
+    Payload.insert(std::end(Payload), apData, apData + aSize);
+
+    ++Count;
+}
+
+void ServerMessageBundle::Clear() noexcept
+{
+    Count = 0;
+    Payload.clear();
+}
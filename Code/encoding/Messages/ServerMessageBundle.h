@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Message.h"
+
+#include <vector>
+
+// Several serialized server messages sent as one packet, each one is length prefixed and starts with its own opcode
+struct ServerMessageBundle final : ServerMessage
+{
+    ServerMessageBundle()
+        : ServerMessage(kServerMessageBundle)
+    {
+    }
+
+    void SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter) const noexcept override;
+    void DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept override;
+
+    bool operator==(const ServerMessageBundle& acRhs) const noexcept
+    {
+        return Count == acRhs.Count &&
+            Payload == acRhs.Payload &&
+            GetOpcode() == acRhs.GetOpcode();
+    }
+
+    void Add(const uint8_t* apData, size_t aSize) noexcept;
+    void Clear() noexcept;
+
+    // Calls acVisitor(const uint8_t*, size_t) for every message, stops at the first malformed entry
+    template<class T>
+    void Visit(const T& acVisitor) const noexcept
+    {
+        size_t position = 0;
+
+        for (uint32_t i = 0; i < Count; ++i)
+        {
+            uint64_t size = 0;
+            for (auto shift = 0; position < Payload.size(); shift += 7)
+            {
+                const auto cByte = Payload[position++];
+                size |= static_cast<uint64_t>(cByte & 0x7F) << shift;
+
+                if ((cByte & 0x80) == 0)
+                    break;
+            }
+
+            if (size > Payload.size() - position)
+                return;
+
+            acVisitor(Payload.data() + position, static_cast<size_t>(size));
+            position += size;
+        }
+    }
+
+    uint32_t Count{};
+    // The server queues bundles across a whole tick, a std::vector never picks up a scoped allocator
+    std::vector<uint8_t> Payload{};
+};
@@ -22,6 +22,12 @@
 #include <Messages/NotifyActorMaxValueChanges.h>
 #include <Messages/NotifyHealthChangeBroadcast.h>
 #include <Messages/NotifySpawnData.h>
+#include <Messages/NotifyCharacterSpawnBatch.h>
+#include <Messages/ServerMessageBundle.h>
+#include <Messages/NotifyPartyMemberStates.h>
+#include <Messages/NotifyPlayerJoined.h>
+#include <Messages/NotifyPlayerLeft.h>
+#include <Messages/NotifyQuestUpdateBatch.h>
 
 #define EXTRACT_MESSAGE(Name) case k##Name: \
     { \
@@ -56,6 +62,12 @@ UniquePtr<ServerMessage> ServerMessageFactory::Extract(TiltedPhoques::Buffer::Re
         EXTRACT_MESSAGE(NotifyActorMaxValueChanges);
         EXTRACT_MESSAGE(NotifyHealthChangeBroadcast);
         EXTRACT_MESSAGE(NotifySpawnData);
+        EXTRACT_MESSAGE(NotifyCharacterSpawnBatch);
+        EXTRACT_MESSAGE(ServerMessageBundle);
+        EXTRACT_MESSAGE(NotifyPartyMemberStates);
+        EXTRACT_MESSAGE(NotifyPlayerJoined);
+        EXTRACT_MESSAGE(NotifyPlayerLeft);
+        EXTRACT_MESSAGE(NotifyQuestUpdateBatch);
     }
 
     return UniquePtr<ServerMessage>(nullptr);
@@ -26,3 +26,14 @@ void ServerReferencesMoveRequest::DeserializeRaw(TiltedPhoques::Buffer::Reader&
         Updates[cServerId].Deserialize(aReader);
     }
 }
+
+EDeliveryClass ServerReferencesMoveRequest::GetDeliveryClass() const noexcept
+{
+    for (const auto& [id, update] : Updates)
+    {
+        if (!update.ActionEvents.empty())
+            return kReliableOrdered;
+    }
+
+    return ServerMessage::GetDeliveryClass();
+}
@@ -2,12 +2,32 @@
 
 void ServerScriptUpdate::SerializeRaw(TiltedPhoques::Buffer::Writer& aWriter) const noexcept
 {
-    Data.Serialize(aWriter);
+    Serialization::WriteBool(aWriter, Reload);
+
+    if (Reload)
+    {
+        Definitions.Serialize(aWriter);
+        ReplicatedObjects.Serialize(aWriter);
+    }
+    else
+    {
+        Data.Serialize(aWriter);
+    }
 }
 
 void ServerScriptUpdate::DeserializeRaw(TiltedPhoques::Buffer::Reader& aReader) noexcept
 {
     ServerMessage::DeserializeRaw(aReader);
 
-    Data.Deserialize(aReader);
+    Reload = Serialization::ReadBool(aReader);
+
+    if (Reload)
+    {
+        Definitions.Deserialize(aReader);
+        ReplicatedObjects.Deserialize(aReader);
+    }
+    else
+    {
+        Data.Deserialize(aReader);
+    }
 }
@@ -2,6 +2,8 @@
 
 #include "Message.h"
 #include <Structs/Objects.h>
+#include <Structs/Scripts.h>
+#include <Structs/FullObjects.h>
 
 struct ServerScriptUpdate final : ServerMessage
 {
@@ -15,9 +17,16 @@ struct ServerScriptUpdate final : ServerMessage
 
     bool operator==(const ServerScriptUpdate& achRhs) const noexcept
     {
-        return Data == achRhs.Data &&
+        return Reload == achRhs.Reload &&
+            Data == achRhs.Data &&
+            Definitions == achRhs.Definitions &&
+            ReplicatedObjects == achRhs.ReplicatedObjects &&
             GetOpcode() == achRhs.GetOpcode();
     }
 
+    // When set the scripts were reloaded, Definitions and ReplicatedObjects replace the client's state and Data is unused
+    bool Reload{ false };
     Objects Data{};
+    Scripts Definitions{};
+    FullObjects ReplicatedObjects{};
 };
@@ -1,23 +1,16 @@
-
 #include <Messages/ServerTimeSettings.h>
+#include <TiltedCore/Serialization.hpp>
 
 void ServerTimeSettings::SerializeRaw(TiltedPhoques::Buffer::Writer &aWriter) const noexcept
 {
-    // poor man's std::bitcast
-    aWriter.WriteBits(*reinterpret_cast<const uint32_t*>(&TimeScale), 32);
-    aWriter.WriteBits(*reinterpret_cast<const uint32_t*>(&Time), 32);
+    Serialization::WriteVarInt(aWriter, GameTime);
+    Serialization::WriteVarInt(aWriter, EpochTick);
+    Serialization::WriteVarInt(aWriter, Rate);
 }
 
 void ServerTimeSettings::DeserializeRaw(TiltedPhoques::Buffer::Reader &aReader) noexcept
 {
-    uint64_t tmp = 0;
-    uint32_t cVal = 0;
-
-    aReader.ReadBits(tmp, 32);
-    cVal = tmp & 0xFFFFFFFF;
-    TimeScale = *reinterpret_cast<float*>(&cVal);
-
-    aReader.ReadBits(tmp, 32);
-    cVal = tmp & 0xFFFFFFFF;
-    Time = *reinterpret_cast<float*>(&cVal);
+    GameTime = Serialization::ReadVarInt(aReader);
+    EpochTick = Serialization::ReadVarInt(aReader);
+    Rate = Serialization::ReadVarInt(aReader) & 0xFFFFFFFF;
 }
@@ -3,6 +3,7 @@
 #include "Message.h"
 #include <Structs/Objects.h>
 
+// Sent on join and whenever the clock is changed, clients extrapolate the time from the epoch in between
 struct ServerTimeSettings final : ServerMessage
 {
     ServerTimeSettings() : ServerMessage(kServerTimeSettings)
@@ -14,10 +15,13 @@ struct ServerTimeSettings final : ServerMessage
 
     bool operator==(const ServerTimeSettings &achRhs) const noexcept
     {
-        return Time == achRhs.Time && TimeScale == achRhs.TimeScale &&
+        return GameTime == achRhs.GameTime && EpochTick == achRhs.EpochTick && Rate == achRhs.Rate &&
                GetOpcode() == achRhs.GetOpcode();
     }
 
-    float Time;
-    float TimeScale;
+    // Game milliseconds at the EpochTick server tick
+    uint64_t GameTime{};
+    uint64_t EpochTick{};
+    // Time scale in thousandths
+    uint32_t Rate{};
 };
@@ -41,5 +41,43 @@ enum ServerOpcode : unsigned char
     kNotifyActorValueChanges,
     kNotifyActorMaxValueChanges,
     kNotifyHealthChangeBroadcast,
-    kNotifySpawnData
+    kNotifySpawnData,
+    kNotifyCharacterSpawnBatch,
+    kServerMessageBundle,
+    kNotifyPartyMemberStates,
+    kNotifyPlayerJoined,
+    kNotifyPlayerLeft,
+    kNotifyQuestUpdateBatch
 };
+
+enum EDeliveryClass : unsigned char
+{
+    // Retransmitted until acknowledged and delivered in order, for anything the other side can't recover from losing
+    kReliableOrdered = 0,
+    // Never retransmitted, for state that is resent often and where only the latest value matters
+    kUnreliableSequenced,
+    kDeliveryClassCount
+};
+
+constexpr EDeliveryClass GetDefaultDeliveryClass(ClientOpcode aOpcode) noexcept
+{
+    switch (aOpcode)
+    {
+    case kClientReferencesMoveRequest:
+        return kUnreliableSequenced;
+    default:
+        return kReliableOrdered;
+    }
+}
+
+constexpr EDeliveryClass GetDefaultDeliveryClass(ServerOpcode aOpcode) noexcept
+{
+    switch (aOpcode)
+    {
+    case kServerReferencesMoveRequest:
+    case kNotifyPartyMemberStates:
+        return kUnreliableSequenced;
+    default:
+        return kReliableOrdered;
+    }
+}
@@ -1,50 +1,222 @@
 #include <Structs/ActorValues.h>
 #include <TiltedCore/Serialization.hpp>
 
+#include <glm/gtc/packing.hpp>
+
+#include <algorithm>
+#include <cstring>
+
 using TiltedPhoques::Serialization;
 
-bool ActorValues::operator==(const ActorValues& acRhs) const noexcept
+namespace
+{
+// Most actor values are small or whole numbers that survive a round trip through a half float, those only take 17 bits
+void WriteValue(TiltedPhoques::Buffer::Writer& aWriter, float aValue) noexcept
 {
-    return ActorValuesList == acRhs.ActorValuesList;
+    const auto cHalf = glm::packHalf1x16(aValue);
+    if (glm::unpackHalf1x16(cHalf) == aValue)
+    {
+        aWriter.WriteBits(1, 1);
+        aWriter.WriteBits(cHalf, 16);
+    }
+    else
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &aValue, sizeof(bits));
+
+        aWriter.WriteBits(0, 1);
+        aWriter.WriteBits(bits, 32);
+    }
 }
 
-bool ActorValues::operator!=(const ActorValues& acRhs) const noexcept
+float ReadValue(TiltedPhoques::Buffer::Reader& aReader) noexcept
 {
-    return !this->operator==(acRhs);
+    uint64_t isHalf = 0;
+    aReader.ReadBits(isHalf, 1);
+
+    uint64_t bits = 0;
+    if (isHalf)
+    {
+        aReader.ReadBits(bits, 16);
+        return glm::unpackHalf1x16(static_cast<uint16_t>(bits));
+    }
+
+    aReader.ReadBits(bits, 32);
+
+    const auto cBits = static_cast<uint32_t>(bits);
+    float value;
+    std::memcpy(&value, &cBits, sizeof(value));
+
+    return value;
+}
 }
 
-void ActorValues::Serialize(TiltedPhoques::Buffer::Writer& aWriter) const noexcept
+ActorValueList::Iterator::Iterator(const ActorValueList* apList, uint32_t aId) noexcept
+    : m_pList(apList)
 {
-    Serialization::WriteVarInt(aWriter, ActorValuesList.size());
-    for (auto& value : ActorValuesList)
+    Seek(aId);
+}
+
+ActorValueList::Iterator& ActorValueList::Iterator::operator++() noexcept
+{
+    Seek(m_current.first + 1);
+
+    return *this;
+}
+
+void ActorValueList::Iterator::Seek(uint32_t aId) noexcept
+{
+    while (aId < kCapacity && !m_pList->contains(aId))
+        ++aId;
+
+    m_current.first = std::min(aId, kCapacity);
+    m_current.second = aId < kCapacity ? m_pList->m_values[aId] : 0.f;
+}
+
+size_t ActorValueList::size() const noexcept
+{
+    size_t count = 0;
+    for (auto word : m_set)
     {
-        Serialization::WriteVarInt(aWriter, value.first);
-        Serialization::WriteFloat(aWriter, value.second);
+        for (; word; word &= word - 1)
+            ++count;
     }
 
-    Serialization::WriteVarInt(aWriter, ActorMaxValuesList.size());
-    for (auto& value : ActorMaxValuesList)
+    return count;
+}
+
+bool ActorValueList::empty() const noexcept
+{
+    return std::all_of(std::begin(m_set), std::end(m_set), [](uint64_t aWord) { return aWord == 0; });
+}
+
+bool ActorValueList::contains(uint32_t aId) const noexcept
+{
+    return aId < kCapacity && (m_set[aId / 64] & (1ull << (aId % 64))) != 0;
+}
+
+void ActorValueList::clear() noexcept
+{
+    m_set.fill(0);
+    m_values.fill(0.f);
+}
+
+float& ActorValueList::operator[](uint32_t aId) noexcept
+{
+    if (aId >= kCapacity)
     {
-        Serialization::WriteVarInt(aWriter, value.first);
-        Serialization::WriteFloat(aWriter, value.second);
+        m_discarded = 0.f;
+        return m_discarded;
     }
+
+    m_set[aId / 64] |= 1ull << (aId % 64);
+
+    return m_values[aId];
 }
 
-void ActorValues::Deserialize(TiltedPhoques::Buffer::Reader& aReader) noexcept
+void ActorValueList::insert(const value_type& acValue) noexcept
+{
+    if (!contains(acValue.first))
+        operator[](acValue.first) = acValue.second;
+}
+
+bool ActorValueList::operator==(const ActorValueList& acRhs) const noexcept
 {
-    auto count = Serialization::ReadVarInt(aReader);
-    for (int i = 0; i < count; i++)
+    if (m_set != acRhs.m_set)
+        return false;
+
+    for (auto& [id, value] : *this)
     {
-        auto key = Serialization::ReadVarInt(aReader);
-        auto value = Serialization::ReadFloat(aReader);
-        ActorValuesList.insert({key, value});
+        if (acRhs.m_values[id] != value)
+            return false;
     }
 
-    auto maxCount = Serialization::ReadVarInt(aReader);
-    for (int i = 0; i < maxCount; i++)
+    return true;
+}
+
+bool ActorValueList::operator!=(const ActorValueList& acRhs) const noexcept
+{
+    return !this->operator==(acRhs);
+}
+
+void ActorValueList::Serialize(TiltedPhoques::Buffer::Writer& aWriter) const noexcept
+{
+    GenerateDiff(nullptr, aWriter);
+}
+
+void ActorValueList::Deserialize(TiltedPhoques::Buffer::Reader& aReader) noexcept
+{
+    clear();
+    ApplyDiff(aReader);
+}
+
+bool ActorValueList::HasChanges(const ActorValueList& acPrevious) const noexcept
+{
+    for (auto& [id, value] : *this)
+    {
+        if (!acPrevious.contains(id) || acPrevious.m_values[id] != value)
+            return true;
+    }
+
+    return false;
+}
+
+void ActorValueList::GenerateDiff(const ActorValueList* apPrevious, TiltedPhoques::Buffer::Writer& aWriter) const noexcept
+{
+    std::array<uint64_t, kMaskWords> changes = m_set;
+
+    if (apPrevious)
+    {
+        for (auto& [id, value] : *this)
+        {
+            if (apPrevious->contains(id) && apPrevious->m_values[id] == value)
+                changes[id / 64] &= ~(1ull << (id % 64));
+        }
+    }
+
+    for (uint32_t i = 0; i < kMaskWords; ++i)
+        aWriter.WriteBits(changes[i], std::min(64u, kCapacity - i * 64));
+
+    for (uint32_t id = 0; id < kCapacity; ++id)
     {
-        auto key = Serialization::ReadVarInt(aReader);
-        auto value = Serialization::ReadFloat(aReader);
-        ActorMaxValuesList.insert({key, value});
+        if (changes[id / 64] & (1ull << (id % 64)))
+            WriteValue(aWriter, m_values[id]);
     }
 }
+
+void ActorValueList::ApplyDiff(TiltedPhoques::Buffer::Reader& aReader) noexcept
+{
+    std::array<uint64_t, kMaskWords> changes{};
+
+    for (uint32_t i = 0; i < kMaskWords; ++i)
+        aReader.ReadBits(changes[i], std::min(64u, kCapacity - i * 64));
+
+    for (uint32_t id = 0; id < kCapacity; ++id)
+    {
+        if (changes[id / 64] & (1ull << (id % 64)))
+            operator[](id) = ReadValue(aReader);
+    }
+}
+
+bool ActorValues::operator==(const ActorValues& acRhs) const noexcept
+{
+    return ActorValuesList == acRhs.ActorValuesList &&
+        ActorMaxValuesList == acRhs.ActorMaxValuesList;
+}
+
+bool ActorValues::operator!=(const ActorValues& acRhs) const noexcept
+{
+    return !this->operator==(acRhs);
+}
+
+void ActorValues::Serialize(TiltedPhoques::Buffer::Writer& aWriter) const noexcept
+{
+    ActorValuesList.Serialize(aWriter);
+    ActorMaxValuesList.Serialize(aWriter);
+}
+
+void ActorValues::Deserialize(TiltedPhoques::Buffer::Reader& aReader) noexcept
+{
+    ActorValuesList.Deserialize(aReader);
+    ActorMaxValuesList.Deserialize(aReader);
+}
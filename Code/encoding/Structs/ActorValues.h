@@ -3,8 +3,77 @@
 #include <TiltedCore/Buffer.hpp>
 #include <TiltedCore/Stl.hpp>
 
+#include <array>
+
 using TiltedPhoques::Map;
 
+// Values indexed by actor value id, the id space is small and fixed per game so everything is stored inline
+struct ActorValueList
+{
+#if TP_FALLOUT
+    static constexpr uint32_t kCapacity = 132;
+#else
+    static constexpr uint32_t kCapacity = 164;
+#endif
+
+    using value_type = std::pair<uint32_t, float>;
+
+    // Visits the values that are set in id order, dereferencing yields an (id, value) pair like a map would
+    struct Iterator
+    {
+        Iterator(const ActorValueList* apList, uint32_t aId) noexcept;
+
+        const value_type& operator*() const noexcept { return m_current; }
+        const value_type* operator->() const noexcept { return &m_current; }
+        Iterator& operator++() noexcept;
+
+        bool operator==(const Iterator& acRhs) const noexcept { return m_current.first == acRhs.m_current.first; }
+        bool operator!=(const Iterator& acRhs) const noexcept { return !operator==(acRhs); }
+
+    private:
+
+        void Seek(uint32_t aId) noexcept;
+
+        const ActorValueList* m_pList;
+        value_type m_current;
+    };
+
+    [[nodiscard]] Iterator begin() const noexcept { return Iterator(this, 0); }
+    [[nodiscard]] Iterator end() const noexcept { return Iterator(this, kCapacity); }
+
+    [[nodiscard]] size_t size() const noexcept;
+    [[nodiscard]] bool empty() const noexcept;
+    [[nodiscard]] bool contains(uint32_t aId) const noexcept;
+    void clear() noexcept;
+
+    // Inserts 0 when the id isn't set yet, writes to ids outside of the game's range are dropped
+    float& operator[](uint32_t aId) noexcept;
+    // Leaves the value untouched when the id is already set
+    void insert(const value_type& acValue) noexcept;
+
+    bool operator==(const ActorValueList& acRhs) const noexcept;
+    bool operator!=(const ActorValueList& acRhs) const noexcept;
+
+    // Presence mask followed by the values that are set
+    void Serialize(TiltedPhoques::Buffer::Writer& aWriter) const noexcept;
+    void Deserialize(TiltedPhoques::Buffer::Reader& aReader) noexcept;
+
+    // True when a value set in this list is missing from acPrevious or differs from it
+    [[nodiscard]] bool HasChanges(const ActorValueList& acPrevious) const noexcept;
+    // Writes the values that are set in this list and differ from apPrevious, everything when it is null
+    void GenerateDiff(const ActorValueList* apPrevious, TiltedPhoques::Buffer::Writer& aWriter) const noexcept;
+    // Sets the values of a diff on top of what the list already holds
+    void ApplyDiff(TiltedPhoques::Buffer::Reader& aReader) noexcept;
+
+private:
+
+    static constexpr uint32_t kMaskWords = (kCapacity + 63) / 64;
+
+    std::array<float, kCapacity> m_values{};
+    std::array<uint64_t, kMaskWords> m_set{};
+    float m_discarded{ 0.f };
+};
+
 struct ActorValues
 {
     ActorValues() = default;
@@ -16,6 +85,6 @@ struct ActorValues
     void Serialize(TiltedPhoques::Buffer::Writer& aWriter) const noexcept;
     void Deserialize(TiltedPhoques::Buffer::Reader& aReader) noexcept;
 
-    Map<uint32_t, float> ActorValuesList{};
-    Map<uint32_t, float> ActorMaxValuesList{};
+    ActorValueList ActorValuesList{};
+    ActorValueList ActorMaxValuesList{};
 };
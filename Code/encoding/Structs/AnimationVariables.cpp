@@ -101,7 +101,7 @@ void AnimationVariables::GenerateDiff(const AnimationVariables& aPrevious, Tilte
 void AnimationVariables::ApplyDiff(TiltedPhoques::Buffer::Reader& aReader)
 {
     const auto cIntegersSize = TiltedPhoques::Serialization::ReadVarInt(aReader);
-    if (cIntegersSize > 0xFF)
+    if (cIntegersSize > kMaxVariables)
         throw std::runtime_error("Too many integers received !");
 
     if (Integers.size() != cIntegersSize)
@@ -110,7 +110,7 @@ void AnimationVariables::ApplyDiff(TiltedPhoques::Buffer::Reader& aReader)
     }
 
     const auto cFloatsSize = TiltedPhoques::Serialization::ReadVarInt(aReader);
-    if (cFloatsSize > 0xFF)
+    if (cIntegersSize + cFloatsSize > kMaxVariables)
         throw std::runtime_error("Too many floats received !");
 
     if (Floats.size() != cFloatsSize)
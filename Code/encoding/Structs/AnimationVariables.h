@@ -3,14 +3,18 @@
 #include <cstdint>
 #include "TiltedCore/Buffer.hpp"
 #include "TiltedCore/Stl.hpp"
+#include "InlineVector.h"
 
 using TiltedPhoques::Vector;
 
 struct AnimationVariables
 {
+    // The diff mask is 64 bits wide, one is used by the booleans, see AnimationGraphDescriptor
+    static constexpr size_t kMaxVariables = 63;
+
     uint64_t Booleans{ 0 };
-    Vector<uint32_t> Integers{};
-    Vector<float> Floats{};
+    InlineVector<uint32_t, kMaxVariables> Integers{};
+    InlineVector<float, kMaxVariables> Floats{};
 
     bool operator==(const AnimationVariables& acRhs) const noexcept;
     bool operator!=(const AnimationVariables& acRhs) const noexcept;
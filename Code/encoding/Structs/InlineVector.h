@@ -0,0 +1,81 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+
+// Fixed capacity vector stored inline, for small arrays that are copied around a lot and shouldn't allocate
+template<class T, size_t N>
+struct InlineVector
+{
+    InlineVector() = default;
+
+    InlineVector(const InlineVector& acRhs) noexcept
+        : m_size(acRhs.m_size)
+    {
+        std::copy_n(acRhs.m_data.data(), m_size, m_data.data());
+    }
+
+    InlineVector& operator=(const InlineVector& acRhs) noexcept
+    {
+        m_size = acRhs.m_size;
+        std::copy_n(acRhs.m_data.data(), m_size, m_data.data());
+
+        return *this;
+    }
+
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return N; }
+    [[nodiscard]] size_t size() const noexcept { return m_size; }
+    [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+
+    [[nodiscard]] T* data() noexcept { return m_data.data(); }
+    [[nodiscard]] const T* data() const noexcept { return m_data.data(); }
+
+    [[nodiscard]] T* begin() noexcept { return m_data.data(); }
+    [[nodiscard]] T* end() noexcept { return m_data.data() + m_size; }
+    [[nodiscard]] const T* begin() const noexcept { return m_data.data(); }
+    [[nodiscard]] const T* end() const noexcept { return m_data.data() + m_size; }
+
+    [[nodiscard]] T& operator[](size_t aIndex) noexcept { assert(aIndex < m_size); return m_data[aIndex]; }
+    [[nodiscard]] const T& operator[](size_t aIndex) const noexcept { assert(aIndex < m_size); return m_data[aIndex]; }
+
+    // Anything past the capacity is dropped
+    void push_back(const T& acValue) noexcept
+    {
+        if (m_size < N)
+            m_data[m_size++] = acValue;
+    }
+
+    void resize(size_t aSize, const T& acValue = T{}) noexcept
+    {
+        aSize = std::min(aSize, N);
+        if (aSize > m_size)
+            std::fill(m_data.data() + m_size, m_data.data() + aSize, acValue);
+
+        m_size = static_cast<uint32_t>(aSize);
+    }
+
+    void assign(size_t aSize, const T& acValue) noexcept
+    {
+        m_size = static_cast<uint32_t>(std::min(aSize, N));
+        std::fill_n(m_data.data(), m_size, acValue);
+    }
+
+    void clear() noexcept { m_size = 0; }
+
+    bool operator==(const InlineVector& acRhs) const noexcept
+    {
+        return m_size == acRhs.m_size && std::equal(begin(), end(), acRhs.begin());
+    }
+
+    bool operator!=(const InlineVector& acRhs) const noexcept
+    {
+        return !operator==(acRhs);
+    }
+
+private:
+
+    uint32_t m_size{ 0 };
+    std::array<T, N> m_data;
+};
@@ -1,15 +1,88 @@
-
 #include <Structs/QuestLog.h>
 
 #include <TiltedCore/Serialization.hpp>
-#include <Structs/Mods.h>
 #include <algorithm>
 
 using TiltedPhoques::Serialization;
 
+const QuestLog::Entry* QuestLog::Find(const GameId& acId) const noexcept
+{
+    const auto itor = m_index.find(ToKey(acId));
+    if (itor == std::end(m_index))
+        return nullptr;
+
+    return &m_entries[itor->second];
+}
+
+const QuestLog::Entry* QuestLog::FindByBaseId(uint32_t aBaseId) const noexcept
+{
+    for (const auto& entry : m_entries)
+    {
+        if (entry.Id.BaseId == aBaseId)
+            return &entry;
+    }
+
+    return nullptr;
+}
+
+bool QuestLog::Set(const GameId& acId, uint16_t aStage) noexcept
+{
+    const auto itor = m_index.find(ToKey(acId));
+    if (itor != std::end(m_index))
+    {
+        auto& entry = m_entries[itor->second];
+        if (entry.Stage == aStage)
+            return false;
+
+        entry.Stage = aStage;
+        return true;
+    }
+
+    m_index[ToKey(acId)] = static_cast<uint32_t>(m_entries.size());
+    m_entries.push_back({acId, aStage});
+
+    return true;
+}
+
+bool QuestLog::Remove(const GameId& acId) noexcept
+{
+    const auto itor = m_index.find(ToKey(acId));
+    if (itor == std::end(m_index))
+        return false;
+
+    const auto cPosition = itor->second;
+    m_index.erase(itor);
+
+    if (cPosition + 1 != m_entries.size())
+    {
+        m_entries[cPosition] = m_entries.back();
+        m_index[ToKey(m_entries[cPosition].Id)] = cPosition;
+    }
+
+    m_entries.pop_back();
+
+    return true;
+}
+
+void QuestLog::clear() noexcept
+{
+    m_entries.clear();
+    m_index.clear();
+}
+
 bool QuestLog::operator==(const QuestLog& acRhs) const noexcept
 {
-    return Entries == acRhs.Entries;
+    if (m_entries.size() != acRhs.m_entries.size())
+        return false;
+
+    for (const auto& entry : m_entries)
+    {
+        const auto* pOther = acRhs.Find(entry.Id);
+        if (!pOther || pOther->Stage != entry.Stage)
+            return false;
+    }
+
+    return true;
 }
 
 bool QuestLog::operator!=(const QuestLog& acRhs) const noexcept
@@ -19,29 +92,64 @@ bool QuestLog::operator!=(const QuestLog& acRhs) const noexcept
 
 void QuestLog::Serialize(TiltedPhoques::Buffer::Writer& aWriter) const noexcept
 {
-    aWriter.WriteBits(Entries.size() & 0xFFFF, 16);
-    for (auto& e : Entries)
+    Vector<const Entry*> sorted;
+    sorted.reserve(m_entries.size());
+
+    for (const auto& entry : m_entries)
+        sorted.push_back(&entry);
+
+    std::sort(std::begin(sorted), std::end(sorted), [](const Entry* apLhs, const Entry* apRhs)
+    {
+        return ToKey(apLhs->Id) < ToKey(apRhs->Id);
+    });
+
+    Serialization::WriteVarInt(aWriter, sorted.size());
+
+    uint32_t previousMod = 0;
+    uint32_t previousBase = 0;
+
+    for (const auto* pEntry : sorted)
     {
-        e.Id.Serialize(aWriter);
+        // Base ids restart from 0 with every mod so the delta never goes negative
+        const auto cModDelta = pEntry->Id.ModId - previousMod;
+        if (cModDelta != 0)
+            previousBase = 0;
+
+        Serialization::WriteVarInt(aWriter, cModDelta);
+        Serialization::WriteVarInt(aWriter, pEntry->Id.BaseId - previousBase);
+        Serialization::WriteVarInt(aWriter, pEntry->Stage);
 
-        // id's can be in the full 16 bit range
-        aWriter.WriteBits(e.Stage, 16);
+        previousMod = pEntry->Id.ModId;
+        previousBase = pEntry->Id.BaseId;
     }
 }
 
 void QuestLog::Deserialize(TiltedPhoques::Buffer::Reader& aReader) noexcept
 {
-    uint64_t temp;
-    aReader.ReadBits(temp, 16);
+    clear();
 
-    const size_t count = temp & 0xFFFF;
-    Entries.resize(count);
+    const auto cCount = Serialization::ReadVarInt(aReader) & 0xFFFF;
 
-    for (auto& e : Entries)
+    m_entries.reserve(cCount);
+
+    uint32_t previousMod = 0;
+    uint32_t previousBase = 0;
+
+    for (auto i = 0u; i < cCount; ++i)
     {
-        e.Id.Deserialize(aReader);
-        aReader.ReadBits(temp, 16);
+        const auto cModDelta = Serialization::ReadVarInt(aReader) & 0xFFFFFFFF;
+        if (cModDelta != 0)
+            previousBase = 0;
+
+        GameId id;
+        id.ModId = static_cast<uint32_t>(previousMod + cModDelta);
+        id.BaseId = static_cast<uint32_t>(previousBase + (Serialization::ReadVarInt(aReader) & 0xFFFFFFFF));
+
+        const auto cStage = static_cast<uint16_t>(Serialization::ReadVarInt(aReader) & 0xFFFF);
+
+        Set(id, cStage);
 
-        e.Stage = temp & 0xFFFF;
+        previousMod = id.ModId;
+        previousBase = id.BaseId;
     }
 }
@@ -5,7 +5,9 @@
 #include <Structs/GameId.h>
 
 using TiltedPhoques::Vector;
+using TiltedPhoques::Map;
 
+// Entries stay dense for iteration and encoding, the index maps a quest to its position so lookups don't scan
 struct QuestLog
 {
     struct Entry
@@ -24,14 +26,36 @@ struct QuestLog
         }
     };
 
-    Vector<Entry> Entries{};
-
     QuestLog() = default;
     ~QuestLog() = default;
 
+    [[nodiscard]] const Vector<Entry>& GetEntries() const noexcept { return m_entries; }
+    [[nodiscard]] size_t size() const noexcept { return m_entries.size(); }
+    [[nodiscard]] bool empty() const noexcept { return m_entries.empty(); }
+
+    [[nodiscard]] const Entry* Find(const GameId& acId) const noexcept;
+    // Scripts only know the base id, this one scans
+    [[nodiscard]] const Entry* FindByBaseId(uint32_t aBaseId) const noexcept;
+    // Adds the quest or moves it to aStage, returns false when it was already there at that stage
+    bool Set(const GameId& acId, uint16_t aStage) noexcept;
+    bool Remove(const GameId& acId) noexcept;
+    void clear() noexcept;
+
+    // Order doesn't matter, removals move the last entry into the hole
     bool operator==(const QuestLog& acRhs) const noexcept;
     bool operator!=(const QuestLog& acRhs) const noexcept;
 
+    // Sorted by id and delta encoded, a mod's quests sit close together so most entries take 3 or 4 bytes
     void Serialize(TiltedPhoques::Buffer::Writer& aWriter) const noexcept;
     void Deserialize(TiltedPhoques::Buffer::Reader& aReader) noexcept;
+
+private:
+
+    [[nodiscard]] static uint64_t ToKey(const GameId& acId) noexcept
+    {
+        return (static_cast<uint64_t>(acId.ModId) << 32) | acId.BaseId;
+    }
+
+    Vector<Entry> m_entries{};
+    Map<uint64_t, uint32_t> m_index{};
 };
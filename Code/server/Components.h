@@ -10,11 +10,13 @@
 #include <Components/CellIdComponent.h>
 #include <Components/CharacterComponent.h>
 #include <Components/MovementComponent.h>
+#include <Components/MovementHistoryComponent.h>
 #include <Components/AnimationComponent.h>
 #include <Components/ScriptsComponent.h>
 #include <Components/InventoryComponent.h>
 #include <Components/QuestLogComponent.h>
 #include <Components/PartyComponent.h>
 #include <Components/ActorValuesComponent.h>
+#include <Components/SpawnCacheComponent.h>
 
 #undef TP_INTERNAL_COMPONENTS_GUARD
@@ -8,5 +8,14 @@
 
 struct ActorValuesComponent
 {
+    // Actor value id of health in the game's ActorValueInfo list
+#if TP_FALLOUT
+    static constexpr uint32_t kHealthId = 27;
+#else
+    static constexpr uint32_t kHealthId = 24;
+#endif
+
     ActorValues CurrentActorValues{};
+    // Bumped on every write to CurrentActorValues so encoded copies know they are stale
+    uint32_t Version{ 0 };
 };
@@ -9,6 +9,7 @@
 struct AnimationComponent
 {
     Vector<ActionEvent> Actions;
+    AnimationVariables Variables;
     ActionEvent CurrentAction;
     ActionEvent LastSerializedAction;
 };
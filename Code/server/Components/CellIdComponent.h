@@ -6,6 +6,8 @@
 
 struct CellIdComponent
 {
+    CellIdComponent() = default;
+
     CellIdComponent(GameId aCellId)
         : Cell(aCellId)
     {}
@@ -20,5 +22,5 @@ struct CellIdComponent
         return !operator==(acRhs);
     }
 
-    GameId Cell;
+    GameId Cell{};
 };
@@ -15,4 +15,6 @@ struct CharacterComponent
     Tints FaceTints{};
     Factions FactionsContent{};
     bool DirtyFactions{ false };
+    // Bumped on every write to the appearance, tints or factions so encoded copies know they are stale
+    uint32_t Version{ 0 };
 };
@@ -10,4 +10,6 @@ struct InventoryComponent
 {
     Inventory Content{};
     bool DirtyInventory{false};
+    // Bumped on every write to Content so encoded copies know they are stale
+    uint32_t Version{ 0 };
 };
@@ -2,32 +2,111 @@
 
 #include <Components.h>
 
-uint32_t ModsComponent::AddStandard(const String& acpFilename) noexcept
+uint32_t ModsComponent::Acquire(const String& acpFilename, bool aLite) noexcept
 {
-    const auto itor = m_standardMods.find(acpFilename);
-    if (itor != std::end(m_standardMods))
+    const auto itor = m_ids.find(acpFilename);
+    if (itor != std::end(m_ids))
     {
-        itor.value().refCount++;
-        return itor->second.id;
+        m_entries[itor->second].RefCount++;
+        return itor->second;
     }
 
-    const auto id = m_seed++;
-    m_standardMods.emplace(acpFilename, Entry{ id, 1 });
+    uint32_t id;
+    if (!m_freeIds.empty())
+    {
+        id = m_freeIds.back();
+        m_freeIds.pop_back();
+    }
+    else
+    {
+        id = static_cast<uint32_t>(m_entries.size());
+        m_entries.emplace_back();
+    }
+
+    auto& entry = m_entries[id];
+    entry.Filename = acpFilename;
+    entry.RefCount = 1;
+    entry.Lite = aLite;
+    entry.Pinned = false;
+    entry.Used = true;
+
+    m_ids.emplace(acpFilename, id);
 
     return id;
 }
 
-uint32_t ModsComponent::AddLite(const String& acpFilename) noexcept
+void ModsComponent::Release(uint32_t aId) noexcept
+{
+    if (aId >= m_entries.size())
+        return;
+
+    auto& entry = m_entries[aId];
+    if (!entry.Used || entry.RefCount == 0)
+        return;
+
+    if (--entry.RefCount > 0 || entry.Pinned)
+        return;
+
+    m_ids.erase(entry.Filename);
+    entry = Entry{};
+
+    m_freeIds.push_back(aId);
+}
+
+void ModsComponent::Pin(uint32_t aId) noexcept
+{
+    if (aId < m_entries.size() && m_entries[aId].Used)
+        m_entries[aId].Pinned = true;
+}
+
+void ModsComponent::Restore(const String& acpFilename, uint32_t aId, bool aLite) noexcept
 {
-    const auto itor = m_liteMods.find(acpFilename);
-    if (itor != std::end(m_liteMods))
+    if (m_ids.find(acpFilename) != std::end(m_ids))
+        return;
+
+    if (aId >= m_entries.size())
+    {
+        // Ids skipped over are free until a later restore claims them
+        for (auto id = static_cast<uint32_t>(m_entries.size()); id < aId; ++id)
+            m_freeIds.push_back(id);
+
+        m_entries.resize(aId + 1);
+    }
+    else if (m_entries[aId].Used)
     {
-        itor.value().refCount++;
-        return itor->second.id;
+        spdlog::warn("Mod id {} is restored for {} but already belongs to {}", aId, acpFilename.c_str(), m_entries[aId].Filename.c_str());
+        return;
+    }
+    else
+    {
+        const auto itor = std::find(std::begin(m_freeIds), std::end(m_freeIds), aId);
+        if (itor != std::end(m_freeIds))
+            m_freeIds.erase(itor);
     }
 
-    const auto id = m_seed++;
-    m_liteMods.emplace(acpFilename, Entry{ id, 1 });
+    auto& entry = m_entries[aId];
+    entry.Filename = acpFilename;
+    entry.RefCount = 0;
+    entry.Lite = aLite;
+    entry.Pinned = true;
+    entry.Used = true;
 
-    return id;
+    m_ids.emplace(acpFilename, aId);
+}
+
+uint32_t ModsComponent::GetId(const String& acpFilename) const noexcept
+{
+    const auto itor = m_ids.find(acpFilename);
+    if (itor == std::end(m_ids))
+        return kInvalidId;
+
+    return itor->second;
+}
+
+const ModsComponent::Entry* ModsComponent::Get(uint32_t aId) const noexcept
+{
+    if (aId >= m_entries.size() || !m_entries[aId].Used)
+        return nullptr;
+
+    return &m_entries[aId];
 }
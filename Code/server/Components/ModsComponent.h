@@ -4,24 +4,35 @@
 #error Include Components.h instead
 #endif
 
+// Interns mod filenames to server mod ids, ids are recycled once no player references them anymore
 struct ModsComponent
 {
+    static constexpr uint32_t kInvalidId = std::numeric_limits<uint32_t>::max();
+
     struct Entry
     {
-        uint32_t id;
-        uint32_t refCount;
+        String Filename;
+        uint32_t RefCount{ 0 };
+        bool Lite{ false };
+        // Set once the id reached a store, persisted form ids must keep resolving to the same mod so it is never recycled
+        bool Pinned{ false };
+        bool Used{ false };
     };
 
-    uint32_t AddStandard(const String& acpFilename) noexcept;
-    uint32_t AddLite(const String& acpFilename) noexcept;
+    uint32_t Acquire(const String& acpFilename, bool aLite) noexcept;
+    void Release(uint32_t aId) noexcept;
+    void Pin(uint32_t aId) noexcept;
+    // Reserve an id assigned in a previous session so persisted form ids keep resolving to the same mod
+    void Restore(const String& acpFilename, uint32_t aId, bool aLite) noexcept;
 
-    const auto& GetStandardMods() const noexcept { return m_standardMods; }
-    const auto& GetLiteMods() const noexcept { return m_liteMods; }
+    [[nodiscard]] uint32_t GetId(const String& acpFilename) const noexcept;
+    [[nodiscard]] const Entry* Get(uint32_t aId) const noexcept;
+    [[nodiscard]] const Vector<Entry>& GetEntries() const noexcept { return m_entries; }
 
-    using TModList = Map<String, Entry>; 
 private:
 
-    uint32_t m_seed = 0;
-    Map<String, Entry> m_standardMods;
-    Map<String, Entry> m_liteMods;
+    // Indexed by id, unused slots are waiting in m_freeIds
+    Vector<Entry> m_entries;
+    Vector<uint32_t> m_freeIds;
+    Map<String, uint32_t> m_ids;
 };
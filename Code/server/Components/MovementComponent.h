@@ -4,14 +4,12 @@
 #error Include Components.h instead
 #endif
 
-#include <Structs/AnimationVariables.h>
-
+// Hot per tick state only, it is scanned every replication pass so anything bulky belongs in AnimationComponent
 struct MovementComponent
 {
     uint64_t Tick;
     glm::vec3 Position;
     glm::vec3 Rotation;
-    AnimationVariables Variables;
     float Direction;
 
     bool Sent;
@@ -0,0 +1,17 @@
+#pragma once
+
+#ifndef TP_INTERNAL_COMPONENTS_GUARD
+#error Include Components.h instead
+#endif
+
+#include <common/MovementHistory.h>
+
+// Last few movement samples of an actor, used to find out where it was at a given tick
+struct MovementHistoryComponent
+{
+    explicit MovementHistoryComponent(uint32_t aCapacity) noexcept
+        : History(aCapacity)
+    {}
+
+    MovementHistory History;
+};
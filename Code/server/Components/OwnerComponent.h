@@ -6,9 +6,14 @@
 
 struct OwnerComponent
 {
+    // Only used when loading a snapshot, the owner is gone and the entity is orphaned until a client adopts it
+    OwnerComponent() = default;
+
     OwnerComponent(const ConnectionId_t aConnectionId)
         : ConnectionId(aConnectionId)
     {}
 
-    ConnectionId_t ConnectionId;
+    [[nodiscard]] bool IsOrphaned() const noexcept { return ConnectionId == 0; }
+
+    ConnectionId_t ConnectionId{ 0 };
 };
@@ -10,10 +10,35 @@ struct PlayerComponent
         : ConnectionId(aConnectionId)
     {}
 
+    // Stable across connections and restarts, used to find a player's state again
+    [[nodiscard]] String GetPersistentKey() const noexcept
+    {
+        if (DiscordId != 0)
+            return String("discord:") + std::to_string(DiscordId).c_str();
+
+        return String("user:") + Username;
+    }
+
+    static constexpr uint16_t kNoModIndex = 0xFFFF;
+    static constexpr uint16_t kLiteModFlag = 0x8000;
+
+    [[nodiscard]] bool HasMod(uint32_t aModId) const noexcept
+    {
+        return GetModIndex(aModId) != kNoModIndex;
+    }
+
+    // Index of a server mod in the player's load order, lite mods carry kLiteModFlag
+    [[nodiscard]] uint16_t GetModIndex(uint32_t aModId) const noexcept
+    {
+        return aModId < ModRemap.size() ? ModRemap[aModId] : kNoModIndex;
+    }
+
     ConnectionId_t ConnectionId;
     std::optional<entt::entity> Character;
-    Vector<String> Mods;
+    // Server mod ids the player loaded, filenames are interned in ModsComponent
     Vector<uint16_t> ModIds;
+    // Server mod id -> load order index, built once on authentication
+    Vector<uint16_t> ModRemap;
     uint64_t DiscordId;
     String Endpoint;
     String Username;
@@ -0,0 +1,18 @@
+#pragma once
+
+#ifndef TP_INTERNAL_COMPONENTS_GUARD
+#error Include Components.h instead
+#endif
+
+// The state part of a character's spawn message encoded once and reused for every spawn until a version moves
+struct SpawnCacheComponent
+{
+    static constexpr uint32_t kMissing = std::numeric_limits<uint32_t>::max();
+
+    uint32_t CharacterVersion{ kMissing };
+    uint32_t InventoryVersion{ kMissing };
+    uint32_t ActorValuesVersion{ kMissing };
+    // Shared with the messages in flight, a stale state is replaced rather than rewritten. It outlives any scoped
+    // allocator active while it is built so it must not be a TiltedPhoques container
+    std::shared_ptr<const std::vector<uint8_t>> State{};
+};
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <Opcodes.h>
+
+// A server message serialized ahead of time, see GameServer::Encode
+struct EncodedMessage
+{
+    EDeliveryClass DeliveryClass{ kReliableOrdered };
+    std::vector<uint8_t> Data;
+};
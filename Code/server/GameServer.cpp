@@ -30,6 +30,14 @@
 
 #include <Scripts/Player.h>
 
+#include <Services/PersistenceService.h>
+#include <Services/SnapshotService.h>
+
+#include <PacketRecorder.h>
+#include <PacketPipeline.h>
+#include <TickRateController.h>
+#include <NetworkStats.h>
+
 #if TP_PLATFORM_WINDOWS
 #include <windows.h>
 #endif
@@ -43,7 +51,10 @@
 
 GameServer* GameServer::s_pInstance = nullptr;
 
-GameServer::GameServer(uint16_t aPort, bool aPremium, String aName, String aToken) noexcept
+// Leaves room in the 64KB send buffer for the bundle header
+static constexpr size_t cMaxBundleSize = 60 * 1024;
+
+GameServer::GameServer(uint16_t aPort, bool aPremium, String aName, String aToken, bool aHeadless) noexcept
     : m_lastFrameTime(std::chrono::high_resolution_clock::now())
     , m_name(std::move(aName)), m_token(std::move(aToken)),
       m_requestStop(false)
@@ -52,16 +63,21 @@ GameServer::GameServer(uint16_t aPort, bool aPremium, String aName, String aToke
 
     s_pInstance = this;
 
-    while (!Host(aPort, aPremium ? 60 : 20))
+    if (!aHeadless)
     {
-        spdlog::warn("Port {} is already in use, trying {}", aPort, aPort + 1);
-        aPort++;
-    }
+        while (!Host(aPort, aPremium ? 60 : 20))
+        {
+            spdlog::warn("Port {} is already in use, trying {}", aPort, aPort + 1);
+            aPort++;
+        }
 
-    spdlog::info("Server started on port {}", GetPort());
-    SetTitle();
+        spdlog::info("Server started on port {}", GetPort());
+        SetTitle();
+    }
 
     m_pWorld = std::make_unique<World>();
+    m_pPipeline = std::make_unique<PacketPipeline>(0);
+    m_pNetworkStats = std::make_unique<NetworkStats>();
 }
 
 GameServer::~GameServer()
@@ -69,22 +85,102 @@ GameServer::~GameServer()
     s_pInstance = nullptr;
 }
 
-void GameServer::Initialize()
+void GameServer::Initialize(bool aScriptHotReload, const String& acDatabasePath, const String& acSnapshotPath, bool aRestoreSnapshot)
+{
+    // The world has to be restored before the first update, no connection is accepted until then
+    if (!acSnapshotPath.empty())
+        m_pWorld->ctx<SnapshotService>().Initialize(acSnapshotPath, aRestoreSnapshot);
+
+    // Persisted mod ids need to be restored before anyone can join
+    if (!acDatabasePath.empty())
+        m_pWorld->ctx<PersistenceService>().Initialize(acDatabasePath);
+
+    m_pWorld->GetScriptService().Initialize(aScriptHotReload);
+}
+
+void GameServer::StartRecording(const String& acPath) noexcept
+{
+    m_pRecorder = std::make_unique<PacketRecorder>(acPath, static_cast<uint16_t>(GetTickRate()));
+
+    if (!m_pRecorder->IsOpen())
+        m_pRecorder.reset();
+}
+
+void GameServer::StartDecodeWorkers(size_t aCount) noexcept
+{
+    m_pPipeline = std::make_unique<PacketPipeline>(aCount);
+
+    spdlog::info("Decoding packets on {} worker threads", aCount);
+}
+
+void GameServer::ConfigureNetworkStats(uint16_t aMetricsPort, uint32_t aLogInterval) noexcept
+{
+    if (aMetricsPort != 0)
+        m_pNetworkStats->StartEndpoint(aMetricsPort);
+
+    m_pNetworkStats->SetLogInterval(std::chrono::seconds(aLogInterval));
+}
+
+void GameServer::SetMovementHistoryLength(uint32_t aLength) noexcept
+{
+    m_pWorld->GetCharacterService().SetMovementHistoryLength(aLength);
+}
+
+void GameServer::EnableAdaptiveTickRate(uint32_t aMinTickRate, uint32_t aMaxTickRate) noexcept
+{
+    // The transport still ticks at its hosted rate, frames can only be skipped
+    const auto cMaxTickRate = std::min(aMaxTickRate, static_cast<uint32_t>(GetTickRate()));
+
+    m_pTickRateController = std::make_unique<TickRateController>(aMinTickRate, cMaxTickRate);
+}
+
+size_t GameServer::RunFrame(float aDelta) noexcept
 {
-    m_pWorld->GetScriptService().Initialize();
+    const auto cProcessed = m_pPipeline->Drain([this](PacketPipeline::Inbound& aInbound) {
+        if (aInbound.Type == PacketPipeline::Inbound::kDisconnection)
+            HandleDisconnection(aInbound.ConnectionId, static_cast<EDisconnectReason>(aInbound.Reason));
+        else
+            HandleMessage(aInbound.ConnectionId, std::move(aInbound.pMessage));
+    });
+
+    auto& dispatcher = m_pWorld->GetDispatcher();
+
+    dispatcher.trigger(UpdateEvent{aDelta});
+
+    FlushAll();
+
+    return cProcessed;
 }
 
 void GameServer::OnUpdate()
 {
+    const auto cFrameStart = std::chrono::steady_clock::now();
+    if (m_pTickRateController && !m_pTickRateController->ShouldRun(cFrameStart))
+    {
+        if (m_requestStop)
+            Close();
+
+        return;
+    }
+
     const auto cNow = std::chrono::high_resolution_clock::now();
     const auto cDelta = cNow - m_lastFrameTime;
     m_lastFrameTime = cNow;
 
     const auto cDeltaSeconds = std::chrono::duration_cast<std::chrono::duration<float>>(cDelta).count();
 
-    auto& dispatcher = m_pWorld->GetDispatcher();
+    if (m_pRecorder)
+        m_pRecorder->RecordFrame(GetTick(), cDeltaSeconds);
+
+    const auto cProcessed = RunFrame(cDeltaSeconds);
 
-    dispatcher.trigger(UpdateEvent{cDeltaSeconds});
+    SampleNetworkStats();
+
+    if (m_pTickRateController)
+    {
+        const auto cFrameEnd = std::chrono::steady_clock::now();
+        m_pTickRateController->Report(cFrameEnd, cFrameEnd - cFrameStart, cProcessed, m_pWorld->view<PlayerComponent>().size());
+    }
 
     if (m_requestStop)
         Close();
@@ -92,19 +188,21 @@ void GameServer::OnUpdate()
 
 void GameServer::OnConsume(const void* apData, const uint32_t aSize, const ConnectionId_t aConnectionId)
 {
-    ClientMessageFactory factory;
-    ViewBuffer buf((uint8_t*)apData, aSize);
-    Buffer::Reader reader(&buf);
+    if (m_pRecorder)
+        m_pRecorder->RecordPacket(GetTick(), aConnectionId, apData, aSize);
 
-    auto pMessage = factory.Extract(reader);
-    if(!pMessage)
-    {
-        spdlog::error("Couldn't parse packet from {:x}", aConnectionId);
-        return;
-    }
+    m_pNetworkStats->RecordInbound(aConnectionId, apData, aSize);
+
+    m_pPipeline->PushPacket(aConnectionId, apData, aSize);
+}
 
+void GameServer::HandleMessage(const ConnectionId_t aConnectionId, UniquePtr<ClientMessage> pMessage) noexcept
+{
     auto& dispatcher = m_pWorld->GetDispatcher();
 
+    if (pMessage->GetOpcode() == kClientReferencesMoveRequest)
+        m_pNetworkStats->RecordMovementReceived(aConnectionId, static_cast<const ClientReferencesMoveRequest&>(*pMessage).Tick);
+
     switch(pMessage->GetOpcode())
     {
     case kAuthenticationRequest:
@@ -139,16 +237,30 @@ void GameServer::OnConnection(const ConnectionId_t aHandle)
 {
     spdlog::info("Connection received {:x}", aHandle);
 
+    if (m_pRecorder)
+        m_pRecorder->RecordConnection(GetTick(), aHandle);
+
+    m_pNetworkStats->AddConnection(aHandle);
+
     SetTitle();
 }
 
 void GameServer::OnDisconnection(const ConnectionId_t aConnectionId, EDisconnectReason aReason)
+{
+    spdlog::info("Connection ended {:x}", aConnectionId);
+
+    if (m_pRecorder)
+        m_pRecorder->RecordDisconnection(GetTick(), aConnectionId, static_cast<uint8_t>(aReason));
+
+    // Handled once the connection's last packets have been decoded and processed
+    m_pPipeline->PushDisconnection(aConnectionId, static_cast<uint8_t>(aReason));
+}
+
+void GameServer::HandleDisconnection(const ConnectionId_t aConnectionId, EDisconnectReason aReason) noexcept
 {
     StackAllocator<1 << 14> allocator;
     ScopedAllocator _{ allocator };
 
-    spdlog::info("Connection ended {:x}", aConnectionId);
-
     m_pWorld->GetScriptService().HandlePlayerQuit(aConnectionId, aReason);
 
     Vector<entt::entity> entitiesToDestroy;
@@ -163,6 +275,10 @@ void GameServer::OnDisconnection(const ConnectionId_t aConnectionId, EDisconnect
         {
             m_pWorld->GetDispatcher().trigger(PlayerLeaveEvent(entity));
 
+            auto& mods = m_pWorld->ctx<ModsComponent>();
+            for (auto id : playerComponent.ModIds)
+                mods.Release(id);
+
             entitiesToDestroy.push_back(entity);
             break;
         }
@@ -185,6 +301,9 @@ void GameServer::OnDisconnection(const ConnectionId_t aConnectionId, EDisconnect
         m_pWorld->destroy(entity);
     }
 
+    m_outbound.erase(aConnectionId);
+    m_pNetworkStats->RemoveConnection(aConnectionId);
+
     SetTitle();
 }
 
@@ -196,16 +315,41 @@ void GameServer::Send(const ConnectionId_t aConnectionId, const ServerMessage& a
 
     Buffer buffer(1 << 16);
     Buffer::Writer writer(&buffer);
-    writer.WriteBits(0, 8); // Skip the first byte as it is used by packet
 
     acServerMessage.Serialize(writer);
 
-    TiltedPhoques::PacketView packet(reinterpret_cast<char*>(buffer.GetWriteData()), writer.Size());
-    Server::Send(aConnectionId, &packet);
+    Queue(aConnectionId, acServerMessage.GetDeliveryClass(), buffer.GetWriteData(), writer.Size());
+
+    s_allocator.Reset();
+}
+
+void GameServer::Encode(const ServerMessage& acServerMessage, EncodedMessage& aMessage) noexcept
+{
+    static thread_local TiltedPhoques::ScratchAllocator s_allocator{ 1 << 18 };
+
+    {
+        TiltedPhoques::ScopedAllocator _(s_allocator);
+
+        Buffer buffer(1 << 16);
+        Buffer::Writer writer(&buffer);
+        writer.WriteBits(0, 8); // Skip the first byte as it is used by packet
+
+        acServerMessage.Serialize(writer);
+
+        aMessage.DeliveryClass = acServerMessage.GetDeliveryClass();
+        aMessage.Data.assign(buffer.GetWriteData(), buffer.GetWriteData() + writer.Size());
+    }
 
     s_allocator.Reset();
 }
 
+void GameServer::SendEncoded(const ConnectionId_t aConnectionId, const EncodedMessage& acMessage) const
+{
+    // Skip the byte reserved for the packet header, bundles only carry the messages
+    if (acMessage.Data.size() > 1)
+        Queue(aConnectionId, acMessage.DeliveryClass, acMessage.Data.data() + 1, acMessage.Data.size() - 1);
+}
+
 void GameServer::SendToLoaded(const ServerMessage& acServerMessage) const
 {
     auto playerView = m_pWorld->view<const PlayerComponent, const CellIdComponent>();
@@ -233,6 +377,11 @@ const String& GameServer::GetName() const noexcept
     return m_name;
 }
 
+bool GameServer::IsIdle() const noexcept
+{
+    return GetClientCount() == 0;
+}
+
 void GameServer::Stop() noexcept
 {
     m_requestStop = true;
@@ -273,41 +422,34 @@ void GameServer::HandleAuthenticationRequest(const ConnectionId_t aConnectionId,
         Mods& serverMods = serverResponse.UserMods;
 
         // Note: to lower traffic we only send the mod ids the user can fix in order as other ids will lead to a null form id anyway
-        std::ostringstream oss;
-        oss << "New player {:x} connected with mods\n\t Standard: ";
-        for (auto& standardMod : acRequest->UserMods.StandardMods)
-        {
-            oss << standardMod.Filename << ", ";
-
-            const auto id = mods.AddStandard(standardMod.Filename);
-
-            Mods::Entry entry;
-            entry.Filename = standardMod.Filename;
-            entry.Id = static_cast<uint16_t>(id);
-
-            playerComponent.Mods.push_back(standardMod.Filename);
-            playerComponent.ModIds.push_back(entry.Id);
+        auto& userMods = acRequest->UserMods;
+        const auto cModCount = userMods.StandardMods.size() + userMods.LiteMods.size();
 
-            serverMods.StandardMods.push_back(entry);
-        }
-
-        oss << "\n\t Lite: ";
-        for (auto& liteMod : acRequest->UserMods.LiteMods)
-        {
-            oss << liteMod.Filename << ", ";
+        playerComponent.ModIds.reserve(cModCount);
+        serverMods.StandardMods.reserve(userMods.StandardMods.size());
+        serverMods.LiteMods.reserve(userMods.LiteMods.size());
 
-            const auto id = mods.AddLite(liteMod.Filename);
+        const auto addMods = [&](Vector<Mods::Entry>& aUserMods, Vector<Mods::Entry>& aServerMods, bool aLite) {
+            for (auto& userMod : aUserMods)
+            {
+                const auto cId = static_cast<uint16_t>(mods.Acquire(userMod.Filename, aLite));
+                const auto cIndex = static_cast<uint16_t>(aLite ? ((userMod.Id & 0xFFF) | PlayerComponent::kLiteModFlag) : (userMod.Id & 0xFF));
 
-            Mods::Entry entry;
-            entry.Filename = liteMod.Filename;
-            entry.Id = static_cast<uint16_t>(id);
+                if (cId >= playerComponent.ModRemap.size())
+                    playerComponent.ModRemap.resize(cId + 1, PlayerComponent::kNoModIndex);
 
-            playerComponent.Mods.push_back(liteMod.Filename);
-            playerComponent.ModIds.push_back(entry.Id);
+                playerComponent.ModRemap[cId] = cIndex;
+                playerComponent.ModIds.push_back(cId);
 
+                // The request is discarded after this, hand its filename over instead of copying it
+                auto& entry = aServerMods.emplace_back();
+                entry.Filename = std::move(userMod.Filename);
+                entry.Id = cId;
+            }
+        };
 
-            serverMods.LiteMods.push_back(entry);
-        }
+        addMods(userMods.StandardMods, serverMods.StandardMods, false);
+        addMods(userMods.LiteMods, serverMods.LiteMods, true);
 
         Script::Player player(cEntity, *m_pWorld);
         auto [canceled, reason] = scripts.HandlePlayerJoin(player);
@@ -316,12 +458,15 @@ void GameServer::HandleAuthenticationRequest(const ConnectionId_t aConnectionId,
         {
             spdlog::info("New player {:x} has a been rejected because \"{}\".", aConnectionId, reason.c_str());
 
+            for (auto id : playerComponent.ModIds)
+                mods.Release(id);
+
             Kick(aConnectionId);
             m_pWorld->destroy(cEntity);
             return;
         }
 
-        spdlog::info(oss.str(), aConnectionId);
+        spdlog::info("New player {:x} connected with {} standard and {} lite mods", aConnectionId, serverMods.StandardMods.size(), serverMods.LiteMods.size());
 
         serverResponse.ServerScripts = std::move(scripts.SerializeScripts());
         serverResponse.ReplicatedObjects = std::move(scripts.GenerateFull());
@@ -338,6 +483,84 @@ void GameServer::HandleAuthenticationRequest(const ConnectionId_t aConnectionId,
     }
 }
 
+void GameServer::Queue(const ConnectionId_t aConnectionId, EDeliveryClass aDeliveryClass, const uint8_t* apData, size_t aSize) const noexcept
+{
+    m_pNetworkStats->RecordOutbound(aConnectionId, apData, aSize);
+    if (aSize > 0 && apData[0] == kServerReferencesMoveRequest)
+        m_pNetworkStats->RecordMovementSent(aConnectionId, GetTick());
+
+    auto& bundle = m_outbound[aConnectionId][aDeliveryClass];
+
+    // Stay within what a single send buffer can hold, the rest starts a new bundle
+    if (bundle.Count > 0 && bundle.Payload.size() + aSize > cMaxBundleSize)
+        Flush(aConnectionId, aDeliveryClass, bundle);
+
+    bundle.Add(apData, aSize);
+}
+
+void GameServer::Flush(const ConnectionId_t aConnectionId, EDeliveryClass aDeliveryClass, ServerMessageBundle& aBundle) const noexcept
+{
+    if (aBundle.Count == 0)
+        return;
+
+    static thread_local TiltedPhoques::ScratchAllocator s_allocator{ 1 << 18 };
+
+    {
+        TiltedPhoques::ScopedAllocator _(s_allocator);
+
+        Buffer buffer(std::max<size_t>(1 << 16, aBundle.Payload.size() + 16));
+        Buffer::Writer writer(&buffer);
+        writer.WriteBits(0, 8); // Skip the first byte as it is used by packet
+
+        // A lone message goes out as is, the bundle header would only add overhead
+        if (aBundle.Count == 1)
+            aBundle.Visit([&writer](const uint8_t* apData, size_t aSize) { writer.WriteBytes(apData, aSize); });
+        else
+            aBundle.Serialize(writer);
+
+        m_pNetworkStats->RecordPacket(aConnectionId, writer.Size());
+
+        TiltedPhoques::PacketView packet(reinterpret_cast<char*>(buffer.GetWriteData()), writer.Size());
+        Server::Send(aConnectionId, &packet, aDeliveryClass == kUnreliableSequenced ? TiltedPhoques::kUnreliable : TiltedPhoques::kReliable);
+    }
+
+    s_allocator.Reset();
+
+    aBundle.Clear();
+}
+
+void GameServer::FlushAll() noexcept
+{
+    for (auto itor = std::begin(m_outbound); itor != std::end(m_outbound); ++itor)
+    {
+        // Reliable first, it is what the unreliable updates usually refer to
+        for (size_t i = 0; i < kDeliveryClassCount; ++i)
+            Flush(itor->first, static_cast<EDeliveryClass>(i), itor.value()[i]);
+    }
+}
+
+void GameServer::SampleNetworkStats() noexcept
+{
+    const auto cNow = std::chrono::steady_clock::now();
+    if (!m_pNetworkStats->IsPublishDue(cNow))
+        return;
+
+    m_pNetworkStats->ForEachConnection([this](ConnectionId_t aConnectionId) {
+        const auto cStatus = GetConnectionStatus(aConnectionId);
+
+        NetworkStats::Transport transport;
+        transport.Ping = cStatus.m_nPing;
+        // Quality is the fraction of packets delivered, negative while it is still unknown
+        transport.Loss = cStatus.m_flConnectionQualityLocal >= 0.f ? 1.f - cStatus.m_flConnectionQualityLocal : 0.f;
+        transport.PendingReliable = cStatus.m_cbPendingReliable;
+        transport.PendingUnreliable = cStatus.m_cbPendingUnreliable;
+
+        m_pNetworkStats->SetTransport(aConnectionId, transport);
+    });
+
+    m_pNetworkStats->Publish(cNow);
+}
+
 void GameServer::SetTitle() const
 {
     std::string title(m_name.empty() ? "Private server" : m_name);
@@ -3,50 +3,97 @@
 #include <World.h>
 #include <Messages/Message.h>
 #include <Messages/AuthenticationRequest.h>
+#include <Messages/ServerMessageBundle.h>
+#include <EncodedMessage.h>
 
 using TiltedPhoques::String;
 using TiltedPhoques::Server;
 using TiltedPhoques::ConnectionId_t;
 
 struct AuthenticationRequest;
+struct PacketRecorder;
+struct PacketPipeline;
+struct TickRateController;
+struct NetworkStats;
 
 struct GameServer final : Server
 {
-    GameServer(uint16_t aPort, bool aPremium, String aName, String aToken) noexcept;
+    // A headless server never opens a socket, it is driven by a PacketReplayer instead
+    GameServer(uint16_t aPort, bool aPremium, String aName, String aToken, bool aHeadless = false) noexcept;
     virtual ~GameServer();
 
     TP_NOCOPYMOVE(GameServer);
 
-    void Initialize();
+    void Initialize(bool aScriptHotReload, const String& acDatabasePath, const String& acSnapshotPath, bool aRestoreSnapshot);
+
+    // Records all inbound traffic to acPath until the server shuts down
+    void StartRecording(const String& acPath) noexcept;
+
+    // Moves packet decoding off the simulation thread, connections are spread over aCount workers
+    void StartDecodeWorkers(size_t aCount) noexcept;
+
+    // Serves per connection metrics on aMetricsPort when it isn't 0, and logs a summary every aLogInterval seconds when it isn't 0
+    void ConfigureNetworkStats(uint16_t aMetricsPort, uint32_t aLogInterval) noexcept;
+
+    // Number of movement samples kept per actor for lag compensation, 0 disables the history
+    void SetMovementHistoryLength(uint32_t aLength) noexcept;
+
+    // Runs the simulation between the given rates depending on load instead of on every transport tick
+    void EnableAdaptiveTickRate(uint32_t aMinTickRate, uint32_t aMaxTickRate) noexcept;
+
+    // Processes everything decoded since the last frame then updates the world, returns the number of messages processed
+    size_t RunFrame(float aDelta) noexcept;
 
     void OnUpdate() override;
     void OnConsume(const void* apData, uint32_t aSize, ConnectionId_t aConnectionId) override;
     void OnConnection(ConnectionId_t aHandle) override;
     void OnDisconnection(ConnectionId_t aConnectionId, EDisconnectReason aReason) override;
 
+    // Messages are queued per connection and go out together at the end of the frame
     void Send(ConnectionId_t aConnectionId, const ServerMessage& acServerMessage) const;
+    // Encoding is thread safe, services can encode in parallel and send the result from the simulation thread
+    static void Encode(const ServerMessage& acServerMessage, EncodedMessage& aMessage) noexcept;
+    void SendEncoded(ConnectionId_t aConnectionId, const EncodedMessage& acMessage) const;
     void SendToLoaded(const ServerMessage& acServerMessage) const;
     void SendToPlayers(const ServerMessage& acServerMessage) const;
 
     const String& GetName() const noexcept;
 
+    // True when nobody is connected, the main loop can then afford to sleep between updates
+    [[nodiscard]] bool IsIdle() const noexcept;
+
     void Stop() noexcept;
 
     static GameServer* Get() noexcept;
 
 protected:
 
+    void HandleMessage(ConnectionId_t aConnectionId, UniquePtr<ClientMessage> pMessage) noexcept;
+    void HandleDisconnection(ConnectionId_t aConnectionId, EDisconnectReason aReason) noexcept;
     void HandleAuthenticationRequest(ConnectionId_t aConnectionId, const UniquePtr<AuthenticationRequest>& acRequest) noexcept;
 
 private:
 
     void SetTitle() const;
+    void SampleNetworkStats() noexcept;
+
+    void Queue(ConnectionId_t aConnectionId, EDeliveryClass aDeliveryClass, const uint8_t* apData, size_t aSize) const noexcept;
+    void Flush(ConnectionId_t aConnectionId, EDeliveryClass aDeliveryClass, ServerMessageBundle& aBundle) const noexcept;
+    void FlushAll() noexcept;
 
     std::chrono::high_resolution_clock::time_point m_lastFrameTime;
     String m_name;
     String m_token;
 
     std::unique_ptr<World> m_pWorld;
+    std::unique_ptr<PacketRecorder> m_pRecorder;
+    std::unique_ptr<PacketPipeline> m_pPipeline;
+    std::unique_ptr<TickRateController> m_pTickRateController;
+    std::unique_ptr<NetworkStats> m_pNetworkStats;
+
+    // Sending is logically const, only the outbound queue changes
+    // Bundles are kept per delivery class so a lost movement update never holds back reliable traffic
+    mutable Map<ConnectionId_t, std::array<ServerMessageBundle, kDeliveryClassCount>> m_outbound;
 
     bool m_requestStop;
 
@@ -0,0 +1,76 @@
+#include <stdafx.h>
+
+#include <MovementReplication.h>
+#include <Components.h>
+
+#include <Messages/ServerReferencesMoveRequest.h>
+
+void MovementReplication::Gather(entt::registry& aRegistry, Vector<entt::entity>& aDirty) noexcept
+{
+    const auto characterView = aRegistry.view<CellIdComponent, AnimationComponent, OwnerComponent>();
+    const auto movementView = aRegistry.view<MovementComponent>();
+
+    m_entities.clear();
+    m_cells.clear();
+    m_owners.clear();
+    m_updates.clear();
+
+    for (auto entity : aDirty)
+    {
+        // Destroyed since it was marked
+        if (!aRegistry.valid(entity) || !movementView.contains(entity) || !characterView.contains(entity))
+            continue;
+
+        const auto& movementComponent = movementView.get<MovementComponent>(entity);
+
+        const auto& [cellIdComponent, animationComponent, ownerComponent] = characterView.get(entity);
+
+        m_entities.push_back(to_integral(entity));
+        m_cells.push_back(cellIdComponent.Cell);
+        m_owners.push_back(ownerComponent.ConnectionId);
+
+        auto& update = m_updates.emplace_back();
+        auto& movement = update.UpdatedMovement;
+
+        movement.Position = movementComponent.Position;
+
+        movement.Rotation.x = movementComponent.Rotation.x;
+        movement.Rotation.y = movementComponent.Rotation.z;
+
+        movement.Direction = movementComponent.Direction;
+        movement.Variables = animationComponent.Variables;
+
+        update.ActionEvents = animationComponent.Actions;
+    }
+
+    // Only what moved has actions to flush
+    for (auto entity : aDirty)
+    {
+        if (!aRegistry.valid(entity))
+            continue;
+
+        if (auto* pAnimationComponent = aRegistry.try_get<AnimationComponent>(entity))
+        {
+            if (!pAnimationComponent->Actions.empty())
+                pAnimationComponent->LastSerializedAction = pAnimationComponent->Actions[pAnimationComponent->Actions.size() - 1];
+
+            pAnimationComponent->Actions.clear();
+        }
+
+        if (auto* pMovementComponent = aRegistry.try_get<MovementComponent>(entity))
+            pMovementComponent->Sent = true;
+    }
+
+    aDirty.clear();
+}
+
+void MovementReplication::Assemble(ConnectionId_t aConnectionId, const GameId& acCell, ServerReferencesMoveRequest& aMessage) const noexcept
+{
+    for (size_t i = 0; i < m_entities.size(); ++i)
+    {
+        if (m_cells[i] != acCell || m_owners[i] == aConnectionId)
+            continue;
+
+        aMessage.Updates[m_entities[i]] = m_updates[i];
+    }
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <Structs/GameId.h>
+#include <Structs/ReferenceUpdate.h>
+
+struct ServerReferencesMoveRequest;
+
+// Movement replication pass, the registry is only touched while gathering so recipients can be assembled in parallel
+struct MovementReplication
+{
+    // Copies what the dirty entities that still replicate look like into dense arrays, then flushes their actions and
+    // marks every live one as sent, aDirty is emptied
+    void Gather(entt::registry& aRegistry, Vector<entt::entity>& aDirty) noexcept;
+
+    // Adds the gathered updates that a recipient in acCell sees, everything there that aConnectionId doesn't own
+    void Assemble(ConnectionId_t aConnectionId, const GameId& acCell, ServerReferencesMoveRequest& aMessage) const noexcept;
+
+    [[nodiscard]] bool IsEmpty() const noexcept { return m_entities.empty(); }
+
+private:
+
+    // One entry per entity that moved in each array
+    std::vector<uint32_t> m_entities;
+    std::vector<GameId> m_cells;
+    std::vector<ConnectionId_t> m_owners;
+    std::vector<ReferenceUpdate> m_updates;
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+
+// Unbounded lock-free queue, any number of threads may push but only one may pop
+template<class T>
+struct MpscQueue
+{
+    MpscQueue() noexcept
+        : m_head(new Node)
+        , m_pTail(m_head.load(std::memory_order_relaxed))
+    {}
+
+    ~MpscQueue() noexcept
+    {
+        T value;
+        while (TryPop(value))
+            ;
+
+        delete m_pTail;
+    }
+
+    TP_NOCOPYMOVE(MpscQueue);
+
+    void Push(T aValue) noexcept
+    {
+        auto* pNode = new Node;
+        pNode->Value = std::move(aValue);
+
+        auto* pPrevious = m_head.exchange(pNode, std::memory_order_acq_rel);
+        pPrevious->Next.store(pNode, std::memory_order_release);
+    }
+
+    // Consumer only, a push still in flight is simply picked up by the next call
+    bool TryPop(T& aValue) noexcept
+    {
+        auto* pNext = m_pTail->Next.load(std::memory_order_acquire);
+        if (!pNext)
+            return false;
+
+        aValue = std::move(pNext->Value);
+
+        delete m_pTail;
+        m_pTail = pNext;
+
+        return true;
+    }
+
+private:
+
+    struct Node
+    {
+        T Value{};
+        std::atomic<Node*> Next{ nullptr };
+    };
+
+    std::atomic<Node*> m_head;
+    Node* m_pTail;
+};
@@ -0,0 +1,230 @@
+#include <stdafx.h>
+
+#include <NetworkStats.h>
+
+#include <httplib.h>
+
+namespace
+{
+constexpr auto cPublishPeriod = 1s;
+
+// Replication lag of a connection, how far the movement it was last sent is ahead of what it last sent us
+int64_t GetReplicationLag(uint64_t aLastSent, uint64_t aLastReceived) noexcept
+{
+    if (aLastSent == 0 || aLastReceived == 0)
+        return 0;
+
+    return static_cast<int64_t>(aLastSent) - static_cast<int64_t>(aLastReceived);
+}
+
+template<class T>
+void WriteMetric(std::string& aOut, const char* acpName, ConnectionId_t aConnectionId, T aValue)
+{
+    aOut += fmt::format("{}{{connection=\"{:x}\"}} {}\n", acpName, aConnectionId, aValue);
+}
+
+void WriteHeader(std::string& aOut, const char* acpName, const char* acpType, const char* acpHelp)
+{
+    aOut += fmt::format("# HELP {} {}\n# TYPE {} {}\n", acpName, acpHelp, acpName, acpType);
+}
+}
+
+NetworkStats::NetworkStats() noexcept = default;
+
+NetworkStats::~NetworkStats() noexcept
+{
+    if (m_pEndpoint)
+    {
+        m_pEndpoint->stop();
+        m_endpointThread.join();
+    }
+}
+
+bool NetworkStats::StartEndpoint(uint16_t aPort) noexcept
+{
+    m_pEndpoint = std::make_unique<httplib::Server>();
+    m_pEndpoint->Get("/metrics", [this](const httplib::Request&, httplib::Response& aResponse) {
+        std::scoped_lock _{ m_metricsLock };
+        aResponse.set_content(m_metrics, "text/plain; version=0.0.4");
+    });
+
+    if (!m_pEndpoint->bind_to_port("0.0.0.0", aPort))
+    {
+        spdlog::error("Unable to serve network metrics on port {}", aPort);
+        m_pEndpoint.reset();
+        return false;
+    }
+
+    m_endpointThread = std::thread([this]() { m_pEndpoint->listen_after_bind(); });
+
+    spdlog::info("Serving network metrics on port {}", aPort);
+
+    return true;
+}
+
+void NetworkStats::AddConnection(ConnectionId_t aConnectionId) noexcept
+{
+    m_connections[aConnectionId] = Connection{};
+}
+
+void NetworkStats::RemoveConnection(ConnectionId_t aConnectionId) noexcept
+{
+    m_connections.erase(aConnectionId);
+}
+
+void NetworkStats::RecordInbound(ConnectionId_t aConnectionId, const void* apData, size_t aSize) noexcept
+{
+    if (aSize == 0)
+        return;
+
+    const auto itor = m_connections.find(aConnectionId);
+    if (itor == std::end(m_connections))
+        return;
+
+    const auto cOpcode = *static_cast<const uint8_t*>(apData);
+
+    auto& counters = itor.value().In;
+    counters.Bytes[cOpcode] += aSize;
+    counters.Messages[cOpcode]++;
+    counters.TotalBytes += aSize;
+}
+
+void NetworkStats::RecordOutbound(ConnectionId_t aConnectionId, const void* apData, size_t aSize) noexcept
+{
+    if (aSize == 0)
+        return;
+
+    const auto itor = m_connections.find(aConnectionId);
+    if (itor == std::end(m_connections))
+        return;
+
+    const auto cOpcode = *static_cast<const uint8_t*>(apData);
+
+    auto& counters = itor.value().Out;
+    counters.Bytes[cOpcode] += aSize;
+    counters.Messages[cOpcode]++;
+    counters.TotalBytes += aSize;
+}
+
+void NetworkStats::RecordPacket(ConnectionId_t aConnectionId, size_t aSize) noexcept
+{
+    const auto itor = m_connections.find(aConnectionId);
+    if (itor == std::end(m_connections))
+        return;
+
+    itor.value().Packets++;
+    itor.value().PacketBytes += aSize;
+}
+
+void NetworkStats::RecordMovementReceived(ConnectionId_t aConnectionId, uint64_t aTick) noexcept
+{
+    const auto itor = m_connections.find(aConnectionId);
+    if (itor != std::end(m_connections))
+        itor.value().LastMovementReceived = std::max(itor.value().LastMovementReceived, aTick);
+}
+
+void NetworkStats::RecordMovementSent(ConnectionId_t aConnectionId, uint64_t aTick) noexcept
+{
+    const auto itor = m_connections.find(aConnectionId);
+    if (itor != std::end(m_connections))
+        itor.value().LastMovementSent = aTick;
+}
+
+void NetworkStats::SetTransport(ConnectionId_t aConnectionId, const Transport& acTransport) noexcept
+{
+    const auto itor = m_connections.find(aConnectionId);
+    if (itor != std::end(m_connections))
+        itor.value().Link = acTransport;
+}
+
+void NetworkStats::Publish(Clock::time_point aNow) noexcept
+{
+    m_nextPublish = aNow + cPublishPeriod;
+
+    if (m_pEndpoint)
+    {
+        std::string metrics;
+        Render(metrics);
+
+        std::scoped_lock _{ m_metricsLock };
+        m_metrics = std::move(metrics);
+    }
+
+    if (m_logInterval.count() > 0 && aNow - m_lastLog >= m_logInterval)
+    {
+        Log(aNow - m_lastLog);
+        m_lastLog = aNow;
+    }
+}
+
+void NetworkStats::Render(std::string& aOut) const noexcept
+{
+    WriteHeader(aOut, "tp_connection_rtt_ms", "gauge", "Round trip time reported by the transport");
+    for (auto& [id, connection] : m_connections)
+        WriteMetric(aOut, "tp_connection_rtt_ms", id, connection.Link.Ping);
+
+    WriteHeader(aOut, "tp_connection_loss_ratio", "gauge", "Fraction of packets lost as seen by the transport");
+    for (auto& [id, connection] : m_connections)
+        WriteMetric(aOut, "tp_connection_loss_ratio", id, connection.Link.Loss);
+
+    WriteHeader(aOut, "tp_connection_pending_bytes", "gauge", "Bytes queued in the transport waiting to be sent");
+    for (auto& [id, connection] : m_connections)
+    {
+        aOut += fmt::format("tp_connection_pending_bytes{{connection=\"{:x}\",delivery=\"reliable\"}} {}\n", id, connection.Link.PendingReliable);
+        aOut += fmt::format("tp_connection_pending_bytes{{connection=\"{:x}\",delivery=\"unreliable\"}} {}\n", id, connection.Link.PendingUnreliable);
+    }
+
+    WriteHeader(aOut, "tp_connection_replication_lag_ms", "gauge", "Tick of the last movement sent minus the tick of the last movement received");
+    for (auto& [id, connection] : m_connections)
+        WriteMetric(aOut, "tp_connection_replication_lag_ms", id, GetReplicationLag(connection.LastMovementSent, connection.LastMovementReceived));
+
+    WriteHeader(aOut, "tp_connection_sent_packets_total", "counter", "Packets sent after bundling");
+    for (auto& [id, connection] : m_connections)
+        WriteMetric(aOut, "tp_connection_sent_packets_total", id, connection.Packets);
+
+    WriteHeader(aOut, "tp_connection_sent_packet_bytes_total", "counter", "Bytes sent after bundling");
+    for (auto& [id, connection] : m_connections)
+        WriteMetric(aOut, "tp_connection_sent_packet_bytes_total", id, connection.PacketBytes);
+
+    const auto writeCounters = [&aOut, this](const char* acpName, const char* acpHelp, auto acGetter) {
+        WriteHeader(aOut, acpName, "counter", acpHelp);
+        for (auto& [id, connection] : m_connections)
+        {
+            const auto& cValues = acGetter(connection);
+            for (size_t opcode = 0; opcode < cValues.size(); ++opcode)
+            {
+                if (cValues[opcode] != 0)
+                    aOut += fmt::format("{}{{connection=\"{:x}\",opcode=\"{}\"}} {}\n", acpName, id, opcode, cValues[opcode]);
+            }
+        }
+    };
+
+    writeCounters("tp_connection_received_bytes_total", "Message bytes received by opcode", [](const Connection& acConnection) -> const auto& { return acConnection.In.Bytes; });
+    writeCounters("tp_connection_received_messages_total", "Messages received by opcode", [](const Connection& acConnection) -> const auto& { return acConnection.In.Messages; });
+    writeCounters("tp_connection_sent_bytes_total", "Message bytes sent by opcode, before bundling", [](const Connection& acConnection) -> const auto& { return acConnection.Out.Bytes; });
+    writeCounters("tp_connection_sent_messages_total", "Messages sent by opcode", [](const Connection& acConnection) -> const auto& { return acConnection.Out.Messages; });
+}
+
+void NetworkStats::Log(std::chrono::duration<float> aElapsed) noexcept
+{
+    const auto cSeconds = std::max(aElapsed.count(), 1.f);
+
+    for (auto itor = std::begin(m_connections); itor != std::end(m_connections); ++itor)
+    {
+        auto& connection = itor.value();
+
+        const auto cInRate = static_cast<float>(connection.In.TotalBytes - connection.LoggedIn) / cSeconds / 1024.f;
+        const auto cOutRate = static_cast<float>(connection.Out.TotalBytes - connection.LoggedOut) / cSeconds / 1024.f;
+
+        connection.LoggedIn = connection.In.TotalBytes;
+        connection.LoggedOut = connection.Out.TotalBytes;
+
+        // The opcode responsible for most of the outbound traffic is usually what a spike is about
+        const auto cTop = std::max_element(std::begin(connection.Out.Bytes), std::end(connection.Out.Bytes)) - std::begin(connection.Out.Bytes);
+
+        spdlog::info("Connection {:x}: rtt {}ms, loss {:.1f}%, in {:.2f} KB/s, out {:.2f} KB/s (opcode {} {:.1f} KB total), pending {} B, replication lag {}ms",
+                     itor->first, connection.Link.Ping, connection.Link.Loss * 100.f, cInRate, cOutRate, cTop,
+                     static_cast<float>(connection.Out.Bytes[cTop]) / 1024.f, connection.Link.PendingReliable + connection.Link.PendingUnreliable,
+                     GetReplicationLag(connection.LastMovementSent, connection.LastMovementReceived));
+    }
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <thread>
+
+using TiltedPhoques::ConnectionId_t;
+
+namespace httplib
+{
+class Server;
+}
+
+// Per connection traffic counters, exported in the Prometheus text format and summarized in the log
+struct NetworkStats
+{
+    using Clock = std::chrono::steady_clock;
+
+    // What the transport reports about a connection, sampled periodically
+    struct Transport
+    {
+        int Ping{ 0 };
+        float Loss{ 0.f };
+        int PendingReliable{ 0 };
+        int PendingUnreliable{ 0 };
+    };
+
+    NetworkStats() noexcept;
+    ~NetworkStats() noexcept;
+
+    TP_NOCOPYMOVE(NetworkStats);
+
+    // Serves the metrics on http://*:aPort/metrics from a background thread
+    bool StartEndpoint(uint16_t aPort) noexcept;
+    void SetLogInterval(std::chrono::seconds aInterval) noexcept { m_logInterval = aInterval; }
+
+    void AddConnection(ConnectionId_t aConnectionId) noexcept;
+    void RemoveConnection(ConnectionId_t aConnectionId) noexcept;
+
+    // apData starts with the message opcode
+    void RecordInbound(ConnectionId_t aConnectionId, const void* apData, size_t aSize) noexcept;
+    void RecordOutbound(ConnectionId_t aConnectionId, const void* apData, size_t aSize) noexcept;
+    // A packet as it goes out, after bundling
+    void RecordPacket(ConnectionId_t aConnectionId, size_t aSize) noexcept;
+
+    void RecordMovementReceived(ConnectionId_t aConnectionId, uint64_t aTick) noexcept;
+    void RecordMovementSent(ConnectionId_t aConnectionId, uint64_t aTick) noexcept;
+
+    // True when the transport should be sampled and Publish called
+    [[nodiscard]] bool IsPublishDue(Clock::time_point aNow) const noexcept { return aNow >= m_nextPublish; }
+    void SetTransport(ConnectionId_t aConnectionId, const Transport& acTransport) noexcept;
+    void Publish(Clock::time_point aNow) noexcept;
+
+    template<class T>
+    void ForEachConnection(const T& acFunctor) const noexcept
+    {
+        for (auto& [id, _] : m_connections)
+            acFunctor(id);
+    }
+
+private:
+
+    struct Counters
+    {
+        std::array<uint64_t, 256> Bytes{};
+        std::array<uint64_t, 256> Messages{};
+        uint64_t TotalBytes{ 0 };
+    };
+
+    struct Connection
+    {
+        Counters In;
+        Counters Out;
+        uint64_t Packets{ 0 };
+        uint64_t PacketBytes{ 0 };
+
+        uint64_t LastMovementReceived{ 0 };
+        uint64_t LastMovementSent{ 0 };
+
+        Transport Link;
+
+        // Totals at the previous log line, to report rates
+        uint64_t LoggedIn{ 0 };
+        uint64_t LoggedOut{ 0 };
+    };
+
+    void Render(std::string& aOut) const noexcept;
+    void Log(std::chrono::duration<float> aElapsed) noexcept;
+
+    Map<ConnectionId_t, Connection> m_connections;
+
+    Clock::time_point m_nextPublish{};
+    Clock::time_point m_lastLog{ Clock::now() };
+    std::chrono::seconds m_logInterval{ 60 };
+
+    // Rendered on the simulation thread, served from the endpoint thread
+    std::unique_ptr<httplib::Server> m_pEndpoint;
+    std::thread m_endpointThread;
+    std::mutex m_metricsLock;
+    std::string m_metrics;
+};
@@ -0,0 +1,108 @@
+#include <stdafx.h>
+
+#include <PacketPipeline.h>
+#include <Messages/ClientMessageFactory.h>
+
+PacketPipeline::PacketPipeline(size_t aWorkerCount) noexcept
+{
+    m_workers.reserve(aWorkerCount);
+
+    for (size_t i = 0; i < aWorkerCount; ++i)
+    {
+        auto& worker = m_workers.emplace_back(std::make_unique<Worker>());
+        worker->Thread = std::thread(&PacketPipeline::Run, this, std::ref(*worker));
+    }
+}
+
+PacketPipeline::~PacketPipeline() noexcept
+{
+    m_running = false;
+
+    for (auto& worker : m_workers)
+    {
+        {
+            std::scoped_lock _{ worker->Lock };
+        }
+
+        worker->Wakeup.notify_one();
+        worker->Thread.join();
+    }
+}
+
+void PacketPipeline::PushPacket(ConnectionId_t aConnectionId, const void* apData, uint32_t aSize) noexcept
+{
+    const auto* pData = static_cast<const uint8_t*>(apData);
+
+    Route({Inbound::kMessage, aConnectionId, 0, std::vector<uint8_t>(pData, pData + aSize)});
+}
+
+void PacketPipeline::PushDisconnection(ConnectionId_t aConnectionId, uint8_t aReason) noexcept
+{
+    // Goes through the same worker as the packets so it can never overtake them
+    Route({Inbound::kDisconnection, aConnectionId, aReason, {}});
+}
+
+void PacketPipeline::Route(Raw aRaw) noexcept
+{
+    if (m_workers.empty())
+    {
+        Decode(aRaw);
+        return;
+    }
+
+    auto& worker = *m_workers[aRaw.ConnectionId % m_workers.size()];
+
+    {
+        std::scoped_lock _{ worker.Lock };
+        worker.Pending.push_back(std::move(aRaw));
+    }
+
+    worker.Wakeup.notify_one();
+}
+
+void PacketPipeline::Decode(Raw& aRaw) noexcept
+{
+    Inbound inbound;
+    inbound.Type = aRaw.Type;
+    inbound.ConnectionId = aRaw.ConnectionId;
+    inbound.Reason = aRaw.Reason;
+
+    if (aRaw.Type == Inbound::kMessage)
+    {
+        ClientMessageFactory factory;
+        ViewBuffer buf(aRaw.Data.data(), aRaw.Data.size());
+        Buffer::Reader reader(&buf);
+
+        inbound.pMessage = factory.Extract(reader);
+        if (!inbound.pMessage)
+        {
+            spdlog::error("Couldn't parse packet from {:x}", aRaw.ConnectionId);
+            return;
+        }
+    }
+
+    m_decoded.Push(std::move(inbound));
+}
+
+void PacketPipeline::Run(Worker& aWorker) noexcept
+{
+    std::vector<Raw> batch;
+
+    while (true)
+    {
+        {
+            std::unique_lock lock{ aWorker.Lock };
+            aWorker.Wakeup.wait(lock, [&aWorker, this] { return !aWorker.Pending.empty() || !m_running; });
+
+            if (aWorker.Pending.empty())
+                return;
+
+            std::swap(batch, aWorker.Pending);
+        }
+
+        for (auto& raw : batch)
+            Decode(raw);
+
+        batch.clear();
+    }
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <MpscQueue.h>
+#include <Messages/Message.h>
+
+#include <thread>
+#include <condition_variable>
+
+using TiltedPhoques::ConnectionId_t;
+
+// Decodes inbound packets off the simulation thread, the simulation drains the results once per frame
+struct PacketPipeline
+{
+    struct Inbound
+    {
+        enum EType : uint8_t
+        {
+            kMessage,
+            kDisconnection
+        };
+
+        EType Type{ kMessage };
+        ConnectionId_t ConnectionId{ 0 };
+        uint8_t Reason{ 0 };
+        UniquePtr<ClientMessage> pMessage{};
+    };
+
+    // Without workers packets are decoded on the calling thread, which keeps replays deterministic
+    explicit PacketPipeline(size_t aWorkerCount) noexcept;
+    ~PacketPipeline() noexcept;
+
+    TP_NOCOPYMOVE(PacketPipeline);
+
+    [[nodiscard]] size_t GetWorkerCount() const noexcept { return m_workers.size(); }
+
+    // Network thread
+    void PushPacket(ConnectionId_t aConnectionId, const void* apData, uint32_t aSize) noexcept;
+    void PushDisconnection(ConnectionId_t aConnectionId, uint8_t aReason) noexcept;
+
+    // Simulation thread, returns how many entries were handled
+    template<class T>
+    size_t Drain(const T& acHandler) noexcept
+    {
+        size_t count = 0;
+
+        Inbound inbound;
+        while (m_decoded.TryPop(inbound))
+        {
+            acHandler(inbound);
+            ++count;
+        }
+
+        return count;
+    }
+
+private:
+
+    struct Raw
+    {
+        Inbound::EType Type;
+        ConnectionId_t ConnectionId;
+        uint8_t Reason;
+        std::vector<uint8_t> Data;
+    };
+
+    // A connection always lands on the same worker so its packets stay in order
+    struct Worker
+    {
+        std::thread Thread;
+        std::mutex Lock;
+        std::condition_variable Wakeup;
+        std::vector<Raw> Pending;
+    };
+
+    void Route(Raw aRaw) noexcept;
+    void Decode(Raw& aRaw) noexcept;
+    void Run(Worker& aWorker) noexcept;
+
+    MpscQueue<Inbound> m_decoded;
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::atomic<bool> m_running{ true };
+};
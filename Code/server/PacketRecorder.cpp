@@ -0,0 +1,100 @@
+#include <stdafx.h>
+
+#include <PacketRecorder.h>
+
+namespace
+{
+constexpr size_t cFlushThreshold = 1 << 16;
+}
+
+PacketRecorder::PacketRecorder(const String& acPath, uint16_t aTickRate) noexcept
+    : m_file(acPath.c_str(), std::ios::binary | std::ios::trunc)
+{
+    if (!m_file)
+    {
+        spdlog::error("Unable to open packet recording {}", acPath.c_str());
+        return;
+    }
+
+    m_pending.reserve(cFlushThreshold * 2);
+
+    WriteBytes(&cMagic, sizeof(cMagic));
+    WriteBytes(&cVersion, sizeof(cVersion));
+    WriteBytes(&aTickRate, sizeof(aTickRate));
+    Flush();
+
+    spdlog::info("Recording inbound traffic to {}", acPath.c_str());
+}
+
+PacketRecorder::~PacketRecorder() noexcept
+{
+    Flush();
+}
+
+void PacketRecorder::RecordFrame(uint64_t aTick, float aDelta) noexcept
+{
+    WriteHeader(kFrame, aTick);
+    WriteBytes(&aDelta, sizeof(aDelta));
+
+    // Frames are the natural boundary, a crash loses at most the last few frames
+    if (m_pending.size() >= cFlushThreshold)
+        Flush();
+}
+
+void PacketRecorder::RecordConnection(uint64_t aTick, ConnectionId_t aConnectionId) noexcept
+{
+    WriteHeader(kConnection, aTick);
+    WriteVarInt(aConnectionId);
+}
+
+void PacketRecorder::RecordDisconnection(uint64_t aTick, ConnectionId_t aConnectionId, uint8_t aReason) noexcept
+{
+    WriteHeader(kDisconnection, aTick);
+    WriteVarInt(aConnectionId);
+    WriteBytes(&aReason, sizeof(aReason));
+}
+
+void PacketRecorder::RecordPacket(uint64_t aTick, ConnectionId_t aConnectionId, const void* apData, uint32_t aSize) noexcept
+{
+    WriteHeader(kPacket, aTick);
+    WriteVarInt(aConnectionId);
+    WriteVarInt(aSize);
+    WriteBytes(apData, aSize);
+}
+
+void PacketRecorder::WriteHeader(ERecordType aType, uint64_t aTick) noexcept
+{
+    // Ticks only ever grow, storing the delta keeps most of them to a single byte
+    const auto cDelta = aTick >= m_lastTick ? aTick - m_lastTick : 0;
+    m_lastTick = std::max(m_lastTick, aTick);
+
+    m_pending.push_back(aType);
+    WriteVarInt(cDelta);
+}
+
+void PacketRecorder::WriteVarInt(uint64_t aValue) noexcept
+{
+    while (aValue >= 0x80)
+    {
+        m_pending.push_back(static_cast<uint8_t>(aValue | 0x80));
+        aValue >>= 7;
+    }
+
+    m_pending.push_back(static_cast<uint8_t>(aValue));
+}
+
+void PacketRecorder::WriteBytes(const void* apData, size_t aSize) noexcept
+{
+    const auto* pData = static_cast<const uint8_t*>(apData);
+    m_pending.insert(std::end(m_pending), pData, pData + aSize);
+}
+
+void PacketRecorder::Flush() noexcept
+{
+    if (m_pending.empty() || !m_file)
+        return;
+
+    m_file.write(reinterpret_cast<const char*>(m_pending.data()), m_pending.size());
+    m_file.flush();
+    m_pending.clear();
+}
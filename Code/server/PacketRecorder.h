@@ -0,0 +1,43 @@
+#pragma once
+
+#include <fstream>
+
+using TiltedPhoques::ConnectionId_t;
+
+// Append-only log of everything the network layer hands to the game server, see PacketReplayer
+struct PacketRecorder
+{
+    enum ERecordType : uint8_t
+    {
+        kFrame = 0,
+        kConnection,
+        kDisconnection,
+        kPacket
+    };
+
+    static constexpr uint32_t cMagic = 0x52505054; // TPPR
+    static constexpr uint32_t cVersion = 1;
+
+    PacketRecorder(const String& acPath, uint16_t aTickRate) noexcept;
+    ~PacketRecorder() noexcept;
+
+    TP_NOCOPYMOVE(PacketRecorder);
+
+    [[nodiscard]] bool IsOpen() const noexcept { return m_file.is_open(); }
+
+    void RecordFrame(uint64_t aTick, float aDelta) noexcept;
+    void RecordConnection(uint64_t aTick, ConnectionId_t aConnectionId) noexcept;
+    void RecordDisconnection(uint64_t aTick, ConnectionId_t aConnectionId, uint8_t aReason) noexcept;
+    void RecordPacket(uint64_t aTick, ConnectionId_t aConnectionId, const void* apData, uint32_t aSize) noexcept;
+
+private:
+
+    void WriteHeader(ERecordType aType, uint64_t aTick) noexcept;
+    void WriteVarInt(uint64_t aValue) noexcept;
+    void WriteBytes(const void* apData, size_t aSize) noexcept;
+    void Flush() noexcept;
+
+    std::ofstream m_file;
+    std::vector<uint8_t> m_pending;
+    uint64_t m_lastTick{ 0 };
+};
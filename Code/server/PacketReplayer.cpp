@@ -0,0 +1,164 @@
+#include <stdafx.h>
+
+#include <PacketReplayer.h>
+#include <PacketRecorder.h>
+#include <GameServer.h>
+
+#include <optional>
+#include <thread>
+
+namespace
+{
+// Way past anything the transport delivers in one message
+constexpr uint64_t cMaxPacketSize = 1 << 20;
+}
+
+PacketReplayer::PacketReplayer(GameServer& aServer, const String& acPath) noexcept
+    : m_server(aServer)
+    , m_file(acPath.c_str(), std::ios::binary)
+{
+    uint32_t magic = 0, version = 0;
+    if (!ReadBytes(&magic, sizeof(magic)) || !ReadBytes(&version, sizeof(version)) || !ReadBytes(&m_tickRate, sizeof(m_tickRate)))
+    {
+        spdlog::error("Unable to read packet recording {}", acPath.c_str());
+        return;
+    }
+
+    if (magic != PacketRecorder::cMagic || version != PacketRecorder::cVersion)
+    {
+        spdlog::error("{} is not a compatible packet recording", acPath.c_str());
+        return;
+    }
+
+    m_valid = true;
+}
+
+void PacketReplayer::Run(bool aRealTime) noexcept
+{
+    if (!m_valid)
+        return;
+
+    spdlog::info("Replaying a session recorded at {} ticks per second{}", m_tickRate, aRealTime ? "" : " at full speed");
+
+    const auto cStart = std::chrono::steady_clock::now();
+
+    uint64_t tick = 0;
+    // Unset until the first record, a recording may well start at tick 0
+    std::optional<uint64_t> firstTick;
+    uint64_t frames = 0, packets = 0;
+    std::chrono::nanoseconds frameTime{0}, worstFrameTime{0};
+
+    Vector<uint8_t> packet;
+
+    uint8_t type = 0;
+    while (ReadBytes(&type, sizeof(type)))
+    {
+        uint64_t tickDelta = 0;
+        if (!ReadVarInt(tickDelta))
+            break;
+
+        tick += tickDelta;
+        if (!firstTick)
+            firstTick = tick;
+
+        if (aRealTime)
+            std::this_thread::sleep_until(cStart + std::chrono::milliseconds(tick - *firstTick));
+
+        uint64_t connectionId = 0;
+
+        switch (type)
+        {
+        case PacketRecorder::kFrame:
+        {
+            float delta = 0.f;
+            if (!ReadBytes(&delta, sizeof(delta)))
+                break;
+
+            const auto cFrameStart = std::chrono::steady_clock::now();
+
+            m_server.RunFrame(delta);
+
+            const auto cFrameTime = std::chrono::steady_clock::now() - cFrameStart;
+            frameTime += cFrameTime;
+            worstFrameTime = std::max<std::chrono::nanoseconds>(worstFrameTime, cFrameTime);
+            ++frames;
+        }
+        break;
+        case PacketRecorder::kConnection:
+            if (ReadVarInt(connectionId))
+                m_server.OnConnection(static_cast<ConnectionId_t>(connectionId));
+            break;
+        case PacketRecorder::kDisconnection:
+        {
+            uint8_t reason = 0;
+            if (ReadVarInt(connectionId) && ReadBytes(&reason, sizeof(reason)))
+                m_server.OnDisconnection(static_cast<ConnectionId_t>(connectionId), static_cast<Server::EDisconnectReason>(reason));
+        }
+        break;
+        case PacketRecorder::kPacket:
+        {
+            uint64_t size = 0;
+            if (!ReadVarInt(connectionId) || !ReadVarInt(size))
+                break;
+
+            // The size comes from the file, a corrupt or truncated one must not make us allocate whatever it says
+            if (size > cMaxPacketSize)
+            {
+                spdlog::error("Packet of {} bytes in packet recording is larger than {}, stopping replay", size, cMaxPacketSize);
+                m_file.setstate(std::ios::failbit);
+                break;
+            }
+
+            packet.resize(size);
+            if (ReadBytes(packet.data(), packet.size()))
+            {
+                m_server.OnConsume(packet.data(), static_cast<uint32_t>(packet.size()), static_cast<ConnectionId_t>(connectionId));
+                ++packets;
+            }
+        }
+        break;
+        default:
+            spdlog::error("Unknown record type {} in packet recording, stopping replay", type);
+            m_file.setstate(std::ios::failbit);
+            break;
+        }
+
+        if (!m_file)
+            break;
+    }
+
+    const auto cDuration = std::chrono::steady_clock::now() - cStart;
+    const auto cAverageFrameTime = frames ? frameTime / frames : std::chrono::nanoseconds{0};
+
+    spdlog::info("Replayed {} frames and {} packets covering {}s of session in {}ms, frame time avg {}us max {}us",
+                 frames, packets, (tick - firstTick.value_or(tick)) / 1000,
+                 std::chrono::duration_cast<std::chrono::milliseconds>(cDuration).count(),
+                 std::chrono::duration_cast<std::chrono::microseconds>(cAverageFrameTime).count(),
+                 std::chrono::duration_cast<std::chrono::microseconds>(worstFrameTime).count());
+}
+
+bool PacketReplayer::ReadVarInt(uint64_t& aValue) noexcept
+{
+    aValue = 0;
+
+    for (auto shift = 0; shift < 64; shift += 7)
+    {
+        uint8_t byte = 0;
+        if (!ReadBytes(&byte, sizeof(byte)))
+            return false;
+
+        aValue |= static_cast<uint64_t>(byte & 0x7F) << shift;
+
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+
+    return false;
+}
+
+bool PacketReplayer::ReadBytes(void* apData, size_t aSize) noexcept
+{
+    m_file.read(static_cast<char*>(apData), aSize);
+
+    return static_cast<size_t>(m_file.gcount()) == aSize;
+}
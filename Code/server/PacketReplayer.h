@@ -0,0 +1,29 @@
+#pragma once
+
+#include <fstream>
+
+struct GameServer;
+
+// Feeds a PacketRecorder file back into a headless game server, frame by frame
+struct PacketReplayer
+{
+    PacketReplayer(GameServer& aServer, const String& acPath) noexcept;
+    ~PacketReplayer() noexcept = default;
+
+    TP_NOCOPYMOVE(PacketReplayer);
+
+    [[nodiscard]] bool IsOpen() const noexcept { return m_valid; }
+
+    // Replays the whole recording, either paced like the original session or as fast as possible
+    void Run(bool aRealTime) noexcept;
+
+private:
+
+    bool ReadVarInt(uint64_t& aValue) noexcept;
+    bool ReadBytes(void* apData, size_t aSize) noexcept;
+
+    GameServer& m_server;
+    std::ifstream m_file;
+    uint16_t m_tickRate{ 0 };
+    bool m_valid{ false };
+};
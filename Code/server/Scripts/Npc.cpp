@@ -31,4 +31,39 @@ namespace Script
 
         return 0.f;
     }
+
+    float Npc::GetHealth() const
+    {
+        auto* pActorValuesComponent = m_pWorld->try_get<ActorValuesComponent>(m_entity);
+        if (!pActorValuesComponent)
+            return 0.f;
+
+        auto& actorValues = pActorValuesComponent->CurrentActorValues.ActorValuesList;
+        if (!actorValues.contains(ActorValuesComponent::kHealthId))
+            return 0.f;
+
+        return actorValues[ActorValuesComponent::kHealthId];
+    }
+
+    std::optional<glm::vec3> Npc::GetPositionAt(uint64_t aTick) const
+    {
+        const auto* pHistoryComponent = m_pWorld->try_get<MovementHistoryComponent>(m_entity);
+
+        glm::vec3 position, rotation;
+        if (!pHistoryComponent || !pHistoryComponent->History.Sample(aTick, position, rotation))
+            return std::nullopt;
+
+        return position;
+    }
+
+    std::optional<glm::vec3> Npc::GetRotationAt(uint64_t aTick) const
+    {
+        const auto* pHistoryComponent = m_pWorld->try_get<MovementHistoryComponent>(m_entity);
+
+        glm::vec3 position, rotation;
+        if (!pHistoryComponent || !pHistoryComponent->History.Sample(aTick, position, rotation))
+            return std::nullopt;
+
+        return rotation;
+    }
 }
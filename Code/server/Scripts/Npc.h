@@ -11,6 +11,11 @@ namespace Script
         [[nodiscard]] const glm::vec3& GetPosition() const;
         [[nodiscard]] const glm::vec3& GetRotation() const;
         [[nodiscard]] float GetSpeed() const;
+        [[nodiscard]] float GetHealth() const;
+
+        // Where the npc was at aTick according to its movement history, empty when it is not known that far back
+        [[nodiscard]] std::optional<glm::vec3> GetPositionAt(uint64_t aTick) const;
+        [[nodiscard]] std::optional<glm::vec3> GetRotationAt(uint64_t aTick) const;
 
         Npc& operator=(const Npc& acRhs)
         {
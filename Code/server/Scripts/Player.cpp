@@ -16,10 +16,21 @@ namespace Script
         : EntityHandle(aEntity, aWorld)
     {}
 
-    const Vector<String>& Player::GetMods() const
+    Vector<String> Player::GetMods() const
     {
         auto& playerComponent = m_pWorld->get<PlayerComponent>(m_entity);
-        return playerComponent.Mods;
+        const auto& mods = m_pWorld->ctx<ModsComponent>();
+
+        Vector<String> filenames;
+        filenames.reserve(playerComponent.ModIds.size());
+
+        for (auto id : playerComponent.ModIds)
+        {
+            if (const auto* pEntry = mods.Get(id))
+                filenames.push_back(pEntry->Filename);
+        }
+
+        return filenames;
     }
 
     const String& Player::GetIp() const
@@ -75,14 +86,12 @@ namespace Script
 
     bool Player::HasMod(const std::string& aModName) const noexcept
     {
-        auto& mods = m_pWorld->get<PlayerComponent>(m_entity).Mods;
-
-        auto it = std::find_if(mods.begin(), mods.end(), [&aModName](const String& it) {
-            // SOL allocator mismatch crash workaround.
-            return std::strcmp(it.c_str(), aModName.c_str()) == 0;
-        });
+        // SOL allocator mismatch crash workaround, build the key with our allocator
+        const auto cId = m_pWorld->ctx<ModsComponent>().GetId(String(aModName.c_str(), aModName.size()));
+        if (cId == ModsComponent::kInvalidId)
+            return false;
 
-        return it != mods.end();
+        return m_pWorld->get<PlayerComponent>(m_entity).HasMod(cId);
     }
 
     bool Player::RemoveQuest(uint32_t aformId)
@@ -92,18 +101,15 @@ namespace Script
             return false;
 
         auto& questService = m_pWorld->GetQuestService();
-        auto& entries = pQuestComponent->QuestContent.Entries;
-
-        auto it = std::find_if(entries.begin(), entries.end(), [&aformId](const auto& e) 
-        { 
-            return e.Id.BaseId == aformId; 
-        });
+        auto& questLog = pQuestComponent->QuestContent;
 
-        if (it != entries.end())
+        if (const auto* pEntry = questLog.FindByBaseId(aformId))
         {
+            const auto cId = pEntry->Id;
+
             // dispatch the message
-            questService.StartStopQuest(m_entity, it->Id, true);
-            entries.erase(it);
+            questService.StartStopQuest(m_entity, cId, true);
+            questLog.Remove(cId);
 
             return true;
         }
@@ -123,21 +129,8 @@ namespace Script
             aModName.find(".esl") == std::string::npos)
             return sol::nullopt;
 
-        auto& playerComponent = m_pWorld->get<PlayerComponent>(m_entity);
-        auto& playerMods = playerComponent.Mods;
-
-        auto it = std::find_if(playerMods.begin(), playerMods.end(), [&aModName](const auto& it) 
-        {
-            return std::strcmp(it.c_str(), aModName.c_str()) == 0;
-        });
-
-        if (it == playerMods.end())
-            return std::nullopt;
-
-        auto index = it - playerMods.begin();
-
-        // this should probably be an assert instead
-        if (index < 0 || index > playerMods.size())
+        const auto cModId = m_pWorld->ctx<ModsComponent>().GetId(String(aModName.c_str(), aModName.size()));
+        if (cModId == ModsComponent::kInvalidId || !m_pWorld->get<PlayerComponent>(m_entity).HasMod(cModId))
             return std::nullopt;
 
         // if we not set a baseid we should set it to temporary.. :)
@@ -145,18 +138,15 @@ namespace Script
 
         GameId questId;
         questId.BaseId = aformId & 0xFFFFFF;
-        questId.ModId = static_cast<uint32_t>(playerComponent.ModIds[index]);
+        questId.ModId = cModId;
 
         auto& questService = m_pWorld->GetQuestService();
-        auto& entries = pQuestComponent->QuestContent.Entries;
 
         // send it to the recipient
         if (!questService.StartStopQuest(m_entity, questId, false))
             return sol::nullopt;
 
-        auto& newQuest = entries.emplace_back();
-        newQuest.Id = questId;
-        newQuest.Stage = 0;
+        pQuestComponent->QuestContent.Set(questId, 0);
 
         return Quest(aformId, 0, *m_pWorld);
     }
@@ -165,7 +155,7 @@ namespace Script
     {
         if (auto* pQuestComponent = m_pWorld->try_get<QuestLogComponent>(m_entity))
         {
-            auto& entries = pQuestComponent->QuestContent.Entries;
+            auto& entries = pQuestComponent->QuestContent.GetEntries();
 
             Vector<Quest> scriptQuests;
             scriptQuests.reserve(entries.size());
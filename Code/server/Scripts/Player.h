@@ -13,7 +13,7 @@ namespace Script
     {
         Player(entt::entity aEntity, World& aWorld);
 
-        const Vector<String>& GetMods() const;
+        Vector<String> GetMods() const;
         const String& GetIp() const;
         const String& GetName() const;
         const uint64_t GetDiscordId() const;
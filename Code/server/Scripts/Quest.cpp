@@ -9,26 +9,25 @@ namespace Script
 {
     void Quest::SetStage(uint16_t anewStage, std::vector<Player> aPlayers)
     {
-        // update the remote quest nodes
-        size_t counter = 0;
+        auto& questService = m_pWorld->GetQuestService();
+
+        // update the remote quest nodes, the players get them with the rest of this tick's quest updates
         for (auto& player : aPlayers)
         {
             auto handle = player.GetEntityHandle();
-            auto& component = m_pWorld->get<QuestLogComponent>(handle);
-            auto& questList = component.QuestContent.Entries;
+            auto& questLog = m_pWorld->get<QuestLogComponent>(handle).QuestContent;
 
-            auto it = std::find_if(questList.begin(), questList.end(), [this](auto& e)
-            {
-                return e.Id.BaseId == m_id;
-            });
+            const auto* pEntry = questLog.FindByBaseId(m_id);
+            if (!pEntry)
+                continue;
 
-            if (it != questList.end())
-            {
-                it->Stage = anewStage;
-                counter++;
+            NotifyQuestUpdate update;
+            update.Id = pEntry->Id;
+            update.Status = NotifyQuestUpdate::StageUpdate;
+            update.Stage = anewStage;
 
-                // TODO: sync this shit
-            }
+            if (questLog.Set(update.Id, anewStage))
+                questService.QueueUpdate(handle, update);
         }
 
         // update our node
@@ -1,6 +1,7 @@
 #include <stdafx.h>
 #include <Components.h>
 #include <Events/UpdateEvent.h>
+#include <Events/PlayerLeaveEvent.h>
 #include <Messages/RequestActorValueChanges.h>
 #include <Messages/RequestActorMaxValueChanges.h>
 #include <Messages/RequestHealthChangeBroadcast.h>
@@ -14,52 +15,163 @@
 ActorService::ActorService(World& aWorld, entt::dispatcher& aDispatcher) noexcept
     : m_world(aWorld)
 {
+    m_updateConnection = aDispatcher.sink<UpdateEvent>().connect<&ActorService::OnUpdate>(this);
     m_updateHealthConnection = aDispatcher.sink<PacketEvent<RequestActorValueChanges>>().connect<&ActorService::OnActorValueChanges>(this);
     m_updateMaxValueConnection = aDispatcher.sink<PacketEvent<RequestActorMaxValueChanges>>().connect<&ActorService::OnActorMaxValueChanges>(this);
     m_updateDeltaHealthConnection = aDispatcher.sink<PacketEvent<RequestHealthChangeBroadcast>>().connect<&ActorService::OnHealthChangeBroadcast>(this);
+    m_playerLeaveConnection = aDispatcher.sink<PlayerLeaveEvent>().connect<&ActorService::OnPlayerLeave>(this);
+
+    aWorld.GetTimerService().SetInterval(1s, [this]() { SendHealthCorrections(); });
 }
 
 ActorService::~ActorService() noexcept
 {
 }
 
-void ActorService::OnActorValueChanges(const PacketEvent<RequestActorValueChanges>& acMessage) const noexcept
+void ActorService::OnUpdate(const UpdateEvent&) noexcept
 {
-    auto& message = acMessage.Packet;
+    if (m_pendingChanges.empty())
+        return;
 
-    auto actorValuesView = m_world.view<ActorValuesComponent, OwnerComponent>();
-
-    auto itor = actorValuesView.find(static_cast<entt::entity>(message.Id));
+    const auto playerView = m_world.view<PlayerComponent, CellIdComponent>();
 
-    if (itor != std::end(actorValuesView) ||
-        actorValuesView.get<OwnerComponent>(*itor).ConnectionId == acMessage.ConnectionId)
+    for (auto& [entity, changes] : m_pendingChanges)
     {
-        auto& actorValuesComponent = actorValuesView.get<ActorValuesComponent>(*itor);
-        for (auto& [id, value] : message.Values)
+        // Destroyed since the changes came in
+        if (!m_world.valid(entity))
+            continue;
+
+        const auto* pCellIdComponent = m_world.try_get<CellIdComponent>(entity);
+        if (!pCellIdComponent)
+            continue;
+
+        const auto* pOwnerComponent = m_world.try_get<OwnerComponent>(entity);
+        const auto cOwner = pOwnerComponent ? pOwnerComponent->ConnectionId : 0;
+
+        const auto* pActorValuesComponent = m_world.try_get<ActorValuesComponent>(entity);
+
+        auto& sentValues = m_sentValues[entity];
+
+        // Same relevance as movement, only the players in the actor's cell care about it
+        for (auto player : playerView)
         {
-            actorValuesComponent.CurrentActorValues.ActorValuesList[id] = value;
-            auto val = actorValuesComponent.CurrentActorValues.ActorValuesList[id];
-            spdlog::debug("Updating value {:x}:{:f} of {:x}", id, val, message.Id);
+            const auto& playerComponent = playerView.get<PlayerComponent>(player);
+
+            if (playerView.get<CellIdComponent>(player) != *pCellIdComponent)
+            {
+                // The spawn sent when it comes back carries the values of that time, diffs restart from there
+                sentValues.erase(playerComponent.ConnectionId);
+                continue;
+            }
+
+            if (pActorValuesComponent && playerComponent.ConnectionId != cOwner)
+                SendValues(playerComponent.ConnectionId, entity, pActorValuesComponent->CurrentActorValues, sentValues[playerComponent.ConnectionId]);
+
+            float deltaHealth = 0.f;
+            for (auto& [sender, delta] : changes.HealthDeltas)
+            {
+                if (sender != playerComponent.ConnectionId)
+                    deltaHealth += delta;
+            }
+
+            if (deltaHealth != 0.f)
+            {
+                NotifyHealthChangeBroadcast notifyDamageEvent;
+                notifyDamageEvent.Id = World::ToInteger(entity);
+                notifyDamageEvent.DeltaHealth = deltaHealth;
+
+                GameServer::Get()->Send(playerComponent.ConnectionId, notifyDamageEvent);
+            }
         }
     }
 
-    NotifyActorValueChanges notifyChanges;
-    notifyChanges.Id = acMessage.Packet.Id;
-    notifyChanges.Values = acMessage.Packet.Values;
+    m_pendingChanges.clear();
+}
 
-    auto view = m_world.view<PlayerComponent>();
-    for (auto entity : view)
+void ActorService::SendValues(ConnectionId_t aConnectionId, entt::entity aEntity, const ActorValues& acValues, ActorValues& aSentValues) noexcept
+{
+    if (acValues.ActorValuesList.HasChanges(aSentValues.ActorValuesList))
     {
-        auto& player = view.get<PlayerComponent>(entity);
+        NotifyActorValueChanges notifyValues;
+        notifyValues.Id = World::ToInteger(aEntity);
+        notifyValues.Previous = aSentValues.ActorValuesList;
+        notifyValues.Values = acValues.ActorValuesList;
+
+        GameServer::Get()->Send(aConnectionId, notifyValues);
+
+        aSentValues.ActorValuesList = acValues.ActorValuesList;
+    }
+
+    if (acValues.ActorMaxValuesList.HasChanges(aSentValues.ActorMaxValuesList))
+    {
+        NotifyActorMaxValueChanges notifyMaxValues;
+        notifyMaxValues.Id = World::ToInteger(aEntity);
+        notifyMaxValues.Previous = aSentValues.ActorMaxValuesList;
+        notifyMaxValues.Values = acValues.ActorMaxValuesList;
+
+        GameServer::Get()->Send(aConnectionId, notifyMaxValues);
+
+        aSentValues.ActorMaxValuesList = acValues.ActorMaxValuesList;
+    }
+}
+
+void ActorService::SendHealthCorrections() noexcept
+{
+    // Forget what was sent about actors that are gone, ids get recycled
+    for (auto itor = std::begin(m_sentValues); itor != std::end(m_sentValues);)
+    {
+        if (!m_world.valid(itor->first))
+            itor = m_sentValues.erase(itor);
+        else
+            ++itor;
+    }
+
+    if (m_healthCorrections.empty())
+        return;
+
+    const auto playerView = m_world.view<PlayerComponent, CellIdComponent>();
+    const auto actorView = m_world.view<ActorValuesComponent, CellIdComponent, OwnerComponent>();
+
+    for (auto entity : m_healthCorrections)
+    {
+        if (!m_world.valid(entity) || !actorView.contains(entity))
+            continue;
+
+        const auto& [actorValuesComponent, cellIdComponent, ownerComponent] = actorView.get(entity);
+
+        // Deltas can get lost or applied twice on the way, the absolute value puts everyone back in line so it is
+        // sent against an empty previous state even when the recipient was already sent that value
+        NotifyActorValueChanges notifyValues;
+        notifyValues.Id = World::ToInteger(entity);
+        notifyValues.Values[ActorValuesComponent::kHealthId] = actorValuesComponent.CurrentActorValues.ActorValuesList[ActorValuesComponent::kHealthId];
+
+        auto& sentValues = m_sentValues[entity];
 
-        if (player.ConnectionId != acMessage.ConnectionId)
+        for (auto player : playerView)
         {
-            GameServer::Get()->Send(player.ConnectionId, notifyChanges);
+            const auto& playerComponent = playerView.get<PlayerComponent>(player);
+
+            if (playerView.get<CellIdComponent>(player) != cellIdComponent || playerComponent.ConnectionId == ownerComponent.ConnectionId)
+                continue;
+
+            GameServer::Get()->Send(playerComponent.ConnectionId, notifyValues);
+
+            sentValues[playerComponent.ConnectionId].ActorValuesList[ActorValuesComponent::kHealthId] = notifyValues.Values[ActorValuesComponent::kHealthId];
         }
     }
+
+    m_healthCorrections.clear();
 }
 
-void ActorService::OnActorMaxValueChanges(const PacketEvent<RequestActorMaxValueChanges>& acMessage) const noexcept
+void ActorService::OnPlayerLeave(const PlayerLeaveEvent& acEvent) noexcept
+{
+    const auto cConnectionId = m_world.get<PlayerComponent>(acEvent.Entity).ConnectionId;
+
+    for (auto itor = std::begin(m_sentValues); itor != std::end(m_sentValues); ++itor)
+        itor.value().erase(cConnectionId);
+}
+
+void ActorService::OnActorValueChanges(const PacketEvent<RequestActorValueChanges>& acMessage) noexcept
 {
     auto& message = acMessage.Packet;
 
@@ -67,49 +179,78 @@ void ActorService::OnActorMaxValueChanges(const PacketEvent<RequestActorMaxValue
 
     auto itor = actorValuesView.find(static_cast<entt::entity>(message.Id));
 
-    if (itor != std::end(actorValuesView) ||
-        actorValuesView.get<OwnerComponent>(*itor).ConnectionId == acMessage.ConnectionId)
+    // Only the owner gets to change an actor's values
+    if (itor == std::end(actorValuesView) ||
+        actorValuesView.get<OwnerComponent>(*itor).ConnectionId != acMessage.ConnectionId)
+        return;
+
+    auto& actorValuesComponent = actorValuesView.get<ActorValuesComponent>(*itor);
+
+    // What goes out is diffed against what each player was sent, the entry only flags the actor for the next update
+    m_pendingChanges[*itor];
+
+    for (auto& [id, value] : message.Values)
     {
-        auto& actorValuesComponent = actorValuesView.get<ActorValuesComponent>(*itor);
-        for (auto& [id, value] : message.Values)
-        {
-            actorValuesComponent.CurrentActorValues.ActorMaxValuesList[id] = value;
-            auto val = actorValuesComponent.CurrentActorValues.ActorMaxValuesList[id];
-            spdlog::debug("Updating max value {:x}:{:f} of {:x}", id, val, message.Id);
-        }
+        actorValuesComponent.CurrentActorValues.ActorValuesList[id] = value;
+        spdlog::debug("Updating value {:x}:{:f} of {:x}", id, value, message.Id);
+
+        // The owner just told everyone, no need to correct it
+        if (id == ActorValuesComponent::kHealthId)
+            m_healthCorrections.erase(*itor);
     }
 
-    NotifyActorMaxValueChanges notifyChanges;
-    notifyChanges.Id = message.Id;
-    notifyChanges.Values = message.Values;
+    actorValuesComponent.Version++;
+}
 
-    auto view = m_world.view<PlayerComponent>();
-    for (auto entity : view)
-    {
-        auto& player = view.get<PlayerComponent>(entity);
+void ActorService::OnActorMaxValueChanges(const PacketEvent<RequestActorMaxValueChanges>& acMessage) noexcept
+{
+    auto& message = acMessage.Packet;
 
-        if (player.ConnectionId != acMessage.ConnectionId)
-        {
-            GameServer::Get()->Send(player.ConnectionId, notifyChanges);
-        }
+    auto actorValuesView = m_world.view<ActorValuesComponent, OwnerComponent>();
+
+    auto itor = actorValuesView.find(static_cast<entt::entity>(message.Id));
+
+    // Only the owner gets to change an actor's values
+    if (itor == std::end(actorValuesView) ||
+        actorValuesView.get<OwnerComponent>(*itor).ConnectionId != acMessage.ConnectionId)
+        return;
+
+    auto& actorValuesComponent = actorValuesView.get<ActorValuesComponent>(*itor);
+
+    m_pendingChanges[*itor];
+
+    for (auto& [id, value] : message.Values)
+    {
+        actorValuesComponent.CurrentActorValues.ActorMaxValuesList[id] = value;
+        spdlog::debug("Updating max value {:x}:{:f} of {:x}", id, value, message.Id);
     }
+
+    actorValuesComponent.Version++;
 }
 
-void ActorService::OnHealthChangeBroadcast(const PacketEvent<RequestHealthChangeBroadcast>& acMessage) const noexcept
+void ActorService::OnHealthChangeBroadcast(const PacketEvent<RequestHealthChangeBroadcast>& acMessage) noexcept
 {
-    NotifyHealthChangeBroadcast notifyDamageEvent;
-    notifyDamageEvent.Id = acMessage.Packet.Id;
-    notifyDamageEvent.DeltaHealth = acMessage.Packet.DeltaHealth;
+    const auto cEntity = static_cast<entt::entity>(acMessage.Packet.Id);
+    if (!m_world.valid(cEntity))
+        return;
+
+    m_pendingChanges[cEntity].HealthDeltas[acMessage.ConnectionId] += acMessage.Packet.DeltaHealth;
 
-    auto view = m_world.view<PlayerComponent>();
-    for (auto entity : view)
+    // Keep our own copy up to date so late joiners and scripts see the actual health
+    auto* pActorValuesComponent = m_world.try_get<ActorValuesComponent>(cEntity);
+
+    // A delta on top of a health we never received would invent one, wait for the owner to send the real value
+    if (pActorValuesComponent && pActorValuesComponent->CurrentActorValues.ActorValuesList.contains(ActorValuesComponent::kHealthId))
     {
-        auto& player = view.get<PlayerComponent>(entity);
+        auto& actorValues = pActorValuesComponent->CurrentActorValues;
+        auto& health = actorValues.ActorValuesList[ActorValuesComponent::kHealthId];
 
-        if (player.ConnectionId != acMessage.ConnectionId)
-        {
-            GameServer::Get()->Send(player.ConnectionId, notifyDamageEvent);
-        }
+        health = std::max(health + acMessage.Packet.DeltaHealth, 0.f);
+        if (actorValues.ActorMaxValuesList.contains(ActorValuesComponent::kHealthId))
+            health = std::min(health, actorValues.ActorMaxValuesList[ActorValuesComponent::kHealthId]);
+
+        pActorValuesComponent->Version++;
+
+        m_healthCorrections.insert(cEntity);
     }
 }
-
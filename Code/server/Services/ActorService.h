@@ -1,9 +1,11 @@
 #pragma once
 
 #include <Events/PacketEvent.h>
+#include <Structs/ActorValues.h>
 
 struct World;
 struct UpdateEvent;
+struct PlayerLeaveEvent;
 struct TransportService;
 struct RequestActorValueChanges;
 struct RequestActorMaxValueChanges;
@@ -19,11 +21,33 @@ struct ActorService
   private:
     World& m_world;
 
-    void OnActorValueChanges(const PacketEvent<RequestActorValueChanges>& acMessage) const noexcept;
-    void OnActorMaxValueChanges(const PacketEvent<RequestActorMaxValueChanges>& acMessage) const noexcept;
-    void OnHealthChangeBroadcast(const PacketEvent<RequestHealthChangeBroadcast>& acMessage) const noexcept;
+    // An actor changed since the last update, its values are diffed against what each player in its cell was sent
+    struct PendingChanges
+    {
+        // Health deltas summed per sender, so nobody gets its own damage back
+        Map<ConnectionId_t, float> HealthDeltas;
+    };
 
+    void OnUpdate(const UpdateEvent& acEvent) noexcept;
+    // Sends what changed in acValues since aSentValues and records it as sent
+    void SendValues(ConnectionId_t aConnectionId, entt::entity aEntity, const ActorValues& acValues, ActorValues& aSentValues) noexcept;
+    void SendHealthCorrections() noexcept;
+    void OnPlayerLeave(const PlayerLeaveEvent& acEvent) noexcept;
+    void OnActorValueChanges(const PacketEvent<RequestActorValueChanges>& acMessage) noexcept;
+    void OnActorMaxValueChanges(const PacketEvent<RequestActorMaxValueChanges>& acMessage) noexcept;
+    void OnHealthChangeBroadcast(const PacketEvent<RequestHealthChangeBroadcast>& acMessage) noexcept;
+
+    Map<entt::entity, PendingChanges> m_pendingChanges;
+
+    // Last values sent about each actor to each player
+    Map<entt::entity, Map<ConnectionId_t, ActorValues>> m_sentValues;
+
+    // Actors whose health was changed by deltas since the last correction
+    Set<entt::entity> m_healthCorrections;
+
+    entt::scoped_connection m_updateConnection;
     entt::scoped_connection m_updateHealthConnection;
     entt::scoped_connection m_updateMaxValueConnection;
     entt::scoped_connection m_updateDeltaHealthConnection;
+    entt::scoped_connection m_playerLeaveConnection;
 };
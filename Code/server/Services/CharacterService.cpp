@@ -8,7 +8,6 @@
 #include <Events/CharacterSpawnedEvent.h>
 #include <Events/CharacterCellChangeEvent.h>
 #include <Events/PlayerEnterWorldEvent.h>
-#include <Events/UpdateEvent.h>
 #include <Scripts/Npc.h>
 
 #include <Messages/AssignCharacterRequest.h>
@@ -29,7 +28,6 @@
 
 CharacterService::CharacterService(World& aWorld, entt::dispatcher& aDispatcher) noexcept
     : m_world(aWorld)
-    , m_updateConnection(aDispatcher.sink<UpdateEvent>().connect<&CharacterService::OnUpdate>(this))
     , m_characterCellChangeEventConnection(aDispatcher.sink<CharacterCellChangeEvent>().connect<&CharacterService::OnCharacterCellChange>(this))
     , m_characterAssignRequestConnection(aDispatcher.sink<PacketEvent<AssignCharacterRequest>>().connect<&CharacterService::OnAssignCharacterRequest>(this))
     , m_removeChatacterConnection(aDispatcher.sink<PacketEvent<RemoveCharacterRequest>>().connect<&CharacterService::OnRemoveCharacterRequest>(this))
@@ -40,17 +38,18 @@ CharacterService::CharacterService(World& aWorld, entt::dispatcher& aDispatcher)
     , m_characterTravelConnection(aDispatcher.sink<PacketEvent<CharacterTravelRequest>>().connect<&CharacterService::OnCharacterTravel>(this))
     , m_spawnDataConnection(aDispatcher.sink<PacketEvent<RequestSpawnData>>().connect<&CharacterService::OnRequestSpawnData>(this))
 {
+    auto& timerService = aWorld.GetTimerService();
+    timerService.SetInterval(1000ms / 4, [this]() { ProcessInventoryChanges(); });
+    timerService.SetInterval(2000ms, [this]() { ProcessFactionsChanges(); });
+    timerService.SetInterval(1000ms / 50, [this]() { ProcessMovementChanges(); });
 }
 
-void CharacterService::Serialize(const World& aRegistry, entt::entity aEntity, CharacterSpawnRequest* apSpawnRequest) noexcept
+void CharacterService::Serialize(World& aRegistry, entt::entity aEntity, CharacterSpawnRequest* apSpawnRequest) noexcept
 {
     const auto& characterComponent = aRegistry.get<CharacterComponent>(aEntity);
 
     apSpawnRequest->ServerId = World::ToInteger(aEntity);
-    apSpawnRequest->AppearanceBuffer = characterComponent.SaveBuffer;
-    apSpawnRequest->ChangeFlags = characterComponent.ChangeFlags;
-    apSpawnRequest->FaceTints = characterComponent.FaceTints;
-    apSpawnRequest->FactionsContent = characterComponent.FactionsContent;
+    apSpawnRequest->EncodedState = GetEncodedState(aRegistry, aEntity);
 
     const auto* pFormIdComponent = aRegistry.try_get<FormIdComponent>(aEntity);
     if (pFormIdComponent)
@@ -58,18 +57,6 @@ void CharacterService::Serialize(const World& aRegistry, entt::entity aEntity, C
         apSpawnRequest->FormId = pFormIdComponent->Id;
     }
 
-    const auto* pInventoryComponent = aRegistry.try_get<InventoryComponent>(aEntity);
-    if (pInventoryComponent)
-    {
-        apSpawnRequest->InventoryContent = pInventoryComponent->Content;
-    }
-
-    const auto* pActorValuesComponent = aRegistry.try_get<ActorValuesComponent>(aEntity);
-    if (pActorValuesComponent)
-    {
-        apSpawnRequest->InitialActorValues = pActorValuesComponent->CurrentActorValues;
-    }
-
     if (characterComponent.BaseId)
     {
         apSpawnRequest->BaseId = characterComponent.BaseId.Id;
@@ -87,19 +74,98 @@ void CharacterService::Serialize(const World& aRegistry, entt::entity aEntity, C
     apSpawnRequest->LatestAction = animationComponent.CurrentAction;
 }
 
-void CharacterService::OnUpdate(const UpdateEvent&) const noexcept
+void CharacterService::EncodeSpawn(World& aRegistry, entt::entity aEntity, EncodedMessage& aMessage) noexcept
+{
+    CharacterSpawnRequest message;
+    Serialize(aRegistry, aEntity, &message);
+
+    GameServer::Encode(message, aMessage);
+}
+
+std::shared_ptr<const std::vector<uint8_t>> CharacterService::GetEncodedState(World& aRegistry, entt::entity aEntity) noexcept
+{
+    const auto& characterComponent = aRegistry.get<CharacterComponent>(aEntity);
+    const auto* pInventoryComponent = aRegistry.try_get<InventoryComponent>(aEntity);
+    const auto* pActorValuesComponent = aRegistry.try_get<ActorValuesComponent>(aEntity);
+
+    const auto cInventoryVersion = pInventoryComponent ? pInventoryComponent->Version : SpawnCacheComponent::kMissing;
+    const auto cActorValuesVersion = pActorValuesComponent ? pActorValuesComponent->Version : SpawnCacheComponent::kMissing;
+
+    auto& cacheComponent = aRegistry.get_or_emplace<SpawnCacheComponent>(aEntity);
+    if (cacheComponent.State &&
+        cacheComponent.CharacterVersion == characterComponent.Version &&
+        cacheComponent.InventoryVersion == cInventoryVersion &&
+        cacheComponent.ActorValuesVersion == cActorValuesVersion)
+    {
+        return cacheComponent.State;
+    }
+
+    static const Inventory s_emptyInventory{};
+    static const ActorValues s_emptyActorValues{};
+
+    Buffer buffer(1 << 16);
+    Buffer::Writer writer(&buffer);
+
+    CharacterSpawnRequest::SerializeState(writer, characterComponent.ChangeFlags, characterComponent.SaveBuffer,
+                                          pInventoryComponent ? pInventoryComponent->Content : s_emptyInventory,
+                                          characterComponent.FactionsContent, characterComponent.FaceTints,
+                                          pActorValuesComponent ? pActorValuesComponent->CurrentActorValues : s_emptyActorValues);
+
+    cacheComponent.State = std::make_shared<const std::vector<uint8_t>>(buffer.GetWriteData(), buffer.GetWriteData() + writer.Size());
+    cacheComponent.CharacterVersion = characterComponent.Version;
+    cacheComponent.InventoryVersion = cInventoryVersion;
+    cacheComponent.ActorValuesVersion = cActorValuesVersion;
+
+    return cacheComponent.State;
+}
+
+void CharacterService::SetMovementHistoryLength(uint32_t aLength) noexcept
+{
+    m_movementHistoryLength = aLength;
+
+    // Histories are sized on creation, drop them so they are recreated with the new length
+    m_world.clear<MovementHistoryComponent>();
+
+    spdlog::info("Keeping {} movement samples per actor ({} bytes each)", aLength,
+                 aLength * (sizeof(uint64_t) + 2 * sizeof(glm::vec3)));
+}
+
+void CharacterService::MarkMovementDirty(entt::entity aEntity) noexcept
+{
+    auto* pMovementComponent = m_world.try_get<MovementComponent>(aEntity);
+    if (!pMovementComponent || !pMovementComponent->Sent)
+        return;
+
+    pMovementComponent->Sent = false;
+    m_dirtyMovements.push_back(aEntity);
+}
+
+void CharacterService::MarkInventoryDirty(entt::entity aEntity) noexcept
+{
+    auto* pInventoryComponent = m_world.try_get<InventoryComponent>(aEntity);
+    if (!pInventoryComponent || pInventoryComponent->DirtyInventory)
+        return;
+
+    pInventoryComponent->DirtyInventory = true;
+    m_dirtyInventories.push_back(aEntity);
+}
+
+void CharacterService::MarkFactionsDirty(entt::entity aEntity) noexcept
 {
-    ProcessInventoryChanges();
-    ProcessFactionsChanges();
-    ProcessMovementChanges();
+    auto* pCharacterComponent = m_world.try_get<CharacterComponent>(aEntity);
+    if (!pCharacterComponent || pCharacterComponent->DirtyFactions)
+        return;
+
+    pCharacterComponent->DirtyFactions = true;
+    m_dirtyFactions.push_back(aEntity);
 }
 
 void CharacterService::OnCharacterCellChange(const CharacterCellChangeEvent& acEvent) const noexcept
 {
     const auto playerView = m_world.view<PlayerComponent, CellIdComponent>();
 
-    CharacterSpawnRequest spawnMessage;
-    Serialize(m_world, acEvent.Entity, &spawnMessage);
+    // Encoded on the first recipient and shared by all of them
+    EncodedMessage spawnMessage;
 
     NotifyRemoveCharacter removeMessage;
     removeMessage.ServerId = World::ToInteger(acEvent.Entity);
@@ -115,11 +181,16 @@ void CharacterService::OnCharacterCellChange(const CharacterCellChangeEvent& acE
         if (acEvent.OldCell == cellIdComponent.Cell)
             GameServer::Get()->Send(playerComponent.ConnectionId, removeMessage);
         else if (acEvent.NewCell == cellIdComponent.Cell)
-            GameServer::Get()->Send(playerComponent.ConnectionId, spawnMessage);
+        {
+            if (spawnMessage.Data.empty())
+                EncodeSpawn(m_world, acEvent.Entity, spawnMessage);
+
+            GameServer::Get()->SendEncoded(playerComponent.ConnectionId, spawnMessage);
+        }
     }
 }
 
-void CharacterService::OnAssignCharacterRequest(const PacketEvent<AssignCharacterRequest>& acMessage) const noexcept
+void CharacterService::OnAssignCharacterRequest(const PacketEvent<AssignCharacterRequest>& acMessage) noexcept
 {
     auto& message = acMessage.Packet;
     const auto& refId = message.ReferenceId;
@@ -141,9 +212,6 @@ void CharacterService::OnAssignCharacterRequest(const PacketEvent<AssignCharacte
 
         if (itor != std::end(view))
         {
-            // This entity already has an owner
-            spdlog::info("FormId: {:x}:{:x} is already managed", refId.ModId, refId.BaseId);
-
             const auto* pServer = GameServer::Get();
 
             auto& actorValuesComponent = view.get<ActorValuesComponent>(*itor);
@@ -154,6 +222,32 @@ void CharacterService::OnAssignCharacterRequest(const PacketEvent<AssignCharacte
             response.Owner = false;
             response.AllActorValues = actorValuesComponent.CurrentActorValues;
 
+            // Restored from a snapshot and nobody manages it yet, the first client that has it loaded adopts it
+            auto* pOwnerComponent = m_world.try_get<OwnerComponent>(*itor);
+            if (pOwnerComponent && pOwnerComponent->IsOrphaned())
+            {
+                spdlog::info("FormId: {:x}:{:x} was restored and is now managed by {:x}", refId.ModId, refId.BaseId, acMessage.ConnectionId);
+
+                pOwnerComponent->ConnectionId = acMessage.ConnectionId;
+
+                if (auto* pCellIdComponent = m_world.try_get<CellIdComponent>(*itor))
+                    pCellIdComponent->Cell = message.CellId;
+
+                // Whatever tick it was last moved at belongs to the previous owner, the new one starts its own
+                if (auto* pMovementComponent = m_world.try_get<MovementComponent>(*itor))
+                    pMovementComponent->Tick = 0;
+
+                if (!m_world.try_get<ScriptsComponent>(*itor))
+                    m_world.emplace<ScriptsComponent>(*itor);
+
+                response.Owner = true;
+            }
+            else
+            {
+                // This entity already has an owner
+                spdlog::info("FormId: {:x}:{:x} is already managed", refId.ModId, refId.BaseId);
+            }
+
             pServer->Send(acMessage.ConnectionId, response);
             return;
         }
@@ -203,8 +297,7 @@ void CharacterService::OnRemoveCharacterRequest(const PacketEvent<RemoveCharacte
 
 void CharacterService::OnCharacterSpawned(const CharacterSpawnedEvent& acEvent) const noexcept
 {
-    CharacterSpawnRequest message;
-    Serialize(m_world, acEvent.Entity, &message);
+    EncodedMessage message;
 
     const auto& characterCellIdComponent = m_world.get<CellIdComponent>(acEvent.Entity);
     const auto& characterOwnerComponent = m_world.get<OwnerComponent>(acEvent.Entity);
@@ -219,11 +312,14 @@ void CharacterService::OnCharacterSpawned(const CharacterSpawnedEvent& acEvent)
         if (characterOwnerComponent.ConnectionId == playerComponent.ConnectionId || characterCellIdComponent.Cell != cellIdComponent.Cell)
             continue;
 
-        GameServer::Get()->Send(playerComponent.ConnectionId, message);
+        if (message.Data.empty())
+            EncodeSpawn(m_world, acEvent.Entity, message);
+
+        GameServer::Get()->SendEncoded(playerComponent.ConnectionId, message);
     }
 }
 
-void CharacterService::OnReferencesMoveRequest(const PacketEvent<ClientReferencesMoveRequest>& acMessage) const noexcept
+void CharacterService::OnReferencesMoveRequest(const PacketEvent<ClientReferencesMoveRequest>& acMessage) noexcept
 {
     auto view = m_world.view<OwnerComponent, AnimationComponent, MovementComponent>();
 
@@ -236,9 +332,14 @@ void CharacterService::OnReferencesMoveRequest(const PacketEvent<ClientReference
         if (itor == std::end(view) || view.get<OwnerComponent>(*itor).ConnectionId != acMessage.ConnectionId)
             continue;
 
+        auto& movementComponent = view.get<MovementComponent>(*itor);
+
+        // Moves are unreliable so they can arrive late or twice, an older tick must not rewind the state or the history
+        if (message.Tick <= movementComponent.Tick)
+            continue;
+
         Script::Npc npc(*itor, m_world);
 
-        auto& movementComponent = view.get<MovementComponent>(*itor);
         auto& animationComponent = view.get<AnimationComponent>(*itor);
 
         movementComponent.Tick = message.Tick;
@@ -250,7 +351,6 @@ void CharacterService::OnReferencesMoveRequest(const PacketEvent<ClientReference
 
         movementComponent.Position = movement.Position;
         movementComponent.Rotation = glm::vec3(movement.Rotation.x, 0.f, movement.Rotation.y);
-        movementComponent.Variables = movement.Variables;
         movementComponent.Direction = movement.Direction;
 
         auto [canceled, reason] = m_world.GetScriptService().HandleMove(npc);
@@ -259,6 +359,16 @@ void CharacterService::OnReferencesMoveRequest(const PacketEvent<ClientReference
         {
             movementComponent = movementCopy;
         }
+        else
+        {
+            animationComponent.Variables = movement.Variables;
+        }
+
+        if (m_movementHistoryLength > 0)
+        {
+            auto& historyComponent = m_world.get_or_emplace<MovementHistoryComponent>(*itor, m_movementHistoryLength);
+            historyComponent.History.Record(movementComponent.Tick, movementComponent.Position, movementComponent.Rotation);
+        }
 
         for (auto& action : update.ActionEvents)
         {
@@ -270,7 +380,7 @@ void CharacterService::OnReferencesMoveRequest(const PacketEvent<ClientReference
             animationComponent.Actions.push_back(animationComponent.CurrentAction);
         }
 
-        movementComponent.Sent = false;
+        MarkMovementDirty(*itor);
     }
 }
 
@@ -303,7 +413,7 @@ void CharacterService::OnRequestSpawnData(const PacketEvent<RequestSpawnData>& a
     }
 }
 
-void CharacterService::OnInventoryChanges(const PacketEvent<RequestInventoryChanges>& acMessage) const noexcept
+void CharacterService::OnInventoryChanges(const PacketEvent<RequestInventoryChanges>& acMessage) noexcept
 {
     auto view = m_world.view<InventoryComponent, OwnerComponent>();
 
@@ -318,11 +428,13 @@ void CharacterService::OnInventoryChanges(const PacketEvent<RequestInventoryChan
 
         auto& inventoryComponent = view.get<InventoryComponent>(*itor);
         inventoryComponent.Content = inventory;
-        inventoryComponent.DirtyInventory = true;
+        inventoryComponent.Version++;
+
+        MarkInventoryDirty(*itor);
     }
 }
 
-void CharacterService::OnFactionsChanges(const PacketEvent<RequestFactionsChanges>& acMessage) const noexcept
+void CharacterService::OnFactionsChanges(const PacketEvent<RequestFactionsChanges>& acMessage) noexcept
 {
     auto view = m_world.view<CharacterComponent, OwnerComponent>();
 
@@ -337,7 +449,9 @@ void CharacterService::OnFactionsChanges(const PacketEvent<RequestFactionsChange
 
         auto& characterComponent = view.get<CharacterComponent>(*itor);
         characterComponent.FactionsContent = factions;
-        characterComponent.DirtyFactions = true;
+        characterComponent.Version++;
+
+        MarkFactionsDirty(*itor);
     }
 }
 
@@ -381,7 +495,7 @@ void CharacterService::OnCharacterTravel(const PacketEvent<CharacterTravelReques
     m_world.destroy(*it);
 }
 
-void CharacterService::CreateCharacter(const PacketEvent<AssignCharacterRequest>& acMessage) const noexcept
+void CharacterService::CreateCharacter(const PacketEvent<AssignCharacterRequest>& acMessage) noexcept
 {
     auto& message = acMessage.Packet;
 
@@ -429,11 +543,13 @@ void CharacterService::CreateCharacter(const PacketEvent<AssignCharacterRequest>
     movementComponent.Tick = pServer->GetTick();
     movementComponent.Position = message.Position;
     movementComponent.Rotation = {message.Rotation.x, 0.f, message.Rotation.y};
-    movementComponent.Sent = false;
+    movementComponent.Sent = true;
 
     auto& animationComponent = m_world.emplace<AnimationComponent>(cEntity);
     animationComponent.CurrentAction = message.LatestAction;
 
+    MarkMovementDirty(cEntity);
+
     // If this is a player character store a ref and trigger an event
     if (isPlayer)
     {
@@ -475,32 +591,30 @@ void CharacterService::CreateCharacter(const PacketEvent<AssignCharacterRequest>
     dispatcher.trigger(CharacterSpawnedEvent(cEntity));
 }
 
-void CharacterService::ProcessInventoryChanges() const noexcept
+void CharacterService::ProcessInventoryChanges() noexcept
 {
-    static std::chrono::steady_clock::time_point lastSendTimePoint;
-    constexpr auto cDelayBetweenSnapshots = 1000ms / 4;
-
-    const auto now = std::chrono::steady_clock::now();
-    if (now - lastSendTimePoint < cDelayBetweenSnapshots)
-        return;
-
-    lastSendTimePoint = now;
-
     const auto playerView = m_world.view<PlayerComponent, CellIdComponent>();
     const auto characterView = m_world.view < CellIdComponent, InventoryComponent, OwnerComponent >();
 
     Map<ConnectionId_t, NotifyInventoryChanges> messages;
 
-    for (auto entity : characterView)
+    for (auto entity : m_dirtyInventories)
     {
+        // Destroyed since it was marked
+        if (!m_world.valid(entity))
+            continue;
+
+        // Cleared even when nothing is sent, a flag left set would keep the entity from ever being marked again
+        if (auto* pInventoryComponent = m_world.try_get<InventoryComponent>(entity))
+            pInventoryComponent->DirtyInventory = false;
+
+        if (!characterView.contains(entity))
+            continue;
+
         auto& inventoryComponent = characterView.get<InventoryComponent>(entity);
         auto& cellIdComponent = characterView.get<CellIdComponent>(entity);
         auto& ownerComponent = characterView.get<OwnerComponent>(entity);
 
-        // If we have nothing new to send skip this
-        if (inventoryComponent.DirtyInventory == false)
-            continue;
-
         for (auto player : playerView)
         {
             const auto& playerComponent = playerView.get<PlayerComponent>(player);
@@ -513,10 +627,10 @@ void CharacterService::ProcessInventoryChanges() const noexcept
 
             change = inventoryComponent.Content;
         }
-
-        inventoryComponent.DirtyInventory = false;
     }
 
+    m_dirtyInventories.clear();
+
     for (auto [connectionId, message] : messages)
     {
         if (!message.Changes.empty())
@@ -524,32 +638,30 @@ void CharacterService::ProcessInventoryChanges() const noexcept
     }
 }
 
-void CharacterService::ProcessFactionsChanges() const noexcept
+void CharacterService::ProcessFactionsChanges() noexcept
 {
-    static std::chrono::steady_clock::time_point lastSendTimePoint;
-    constexpr auto cDelayBetweenSnapshots = 2000ms;
-
-    const auto now = std::chrono::steady_clock::now();
-    if (now - lastSendTimePoint < cDelayBetweenSnapshots)
-        return;
-
-    lastSendTimePoint = now;
-
     const auto playerView = m_world.view<PlayerComponent, CellIdComponent>();
     const auto characterView = m_world.view < CellIdComponent, CharacterComponent, OwnerComponent>();
 
     Map<ConnectionId_t, NotifyFactionsChanges> messages;
 
-    for (auto entity : characterView)
+    for (auto entity : m_dirtyFactions)
     {
+        // Destroyed since it was marked
+        if (!m_world.valid(entity))
+            continue;
+
+        // Cleared even when nothing is sent, a flag left set would keep the entity from ever being marked again
+        if (auto* pCharacterComponent = m_world.try_get<CharacterComponent>(entity))
+            pCharacterComponent->DirtyFactions = false;
+
+        if (!characterView.contains(entity))
+            continue;
+
         auto& characterComponent = characterView.get<CharacterComponent>(entity);
         auto& cellIdComponent = characterView.get<CellIdComponent>(entity);
         auto& ownerComponent = characterView.get<OwnerComponent>(entity);
 
-        // If we have nothing new to send skip this
-        if (characterComponent.DirtyFactions == false)
-            continue;
-
         for (auto player : playerView)
         {
             const auto& playerComponent = playerView.get<PlayerComponent>(player);
@@ -562,10 +674,10 @@ void CharacterService::ProcessFactionsChanges() const noexcept
 
             change = characterComponent.FactionsContent;
         }
-
-        characterComponent.DirtyFactions = false;
     }
 
+    m_dirtyFactions.clear();
+
     for (auto [connectionId, message] : messages)
     {
         if (!message.Changes.empty())
@@ -573,80 +685,47 @@ void CharacterService::ProcessFactionsChanges() const noexcept
     }
 }
 
-void CharacterService::ProcessMovementChanges() const noexcept
+void CharacterService::ProcessMovementChanges() noexcept
 {
-    static std::chrono::steady_clock::time_point lastSendTimePoint;
-    constexpr auto cDelayBetweenSnapshots = 1000ms / 50;
+    // Gather what changed once into dense arrays, recipients then only walk through those instead of the registry
+    m_movementReplication.Gather(m_world, m_dirtyMovements);
 
-    const auto now = std::chrono::steady_clock::now();
-    if (now - lastSendTimePoint < cDelayBetweenSnapshots)
+    if (m_movementReplication.IsEmpty())
         return;
 
-    lastSendTimePoint = now;
-
-    auto playerView = m_world.view<PlayerComponent, CellIdComponent>();
-    const auto characterView = m_world.view < CellIdComponent, MovementComponent, AnimationComponent, OwnerComponent >();
-
-    Map<ConnectionId_t, ServerReferencesMoveRequest> messages;
+    const auto playerView = m_world.view<PlayerComponent, CellIdComponent>();
 
-    for (auto player : playerView)
-    {
-        const auto& playerComponent = playerView.get<PlayerComponent>(player);
-        auto& message = messages[playerComponent.ConnectionId];
+    Vector<entt::entity> recipients(std::begin(playerView), std::end(playerView));
+    m_encodedMovements.resize(recipients.size());
 
-        message.Tick = GameServer::Get()->GetTick();
-    }
+    const auto cTick = GameServer::Get()->GetTick();
 
-    for (auto entity : characterView)
-    {
-        auto& movementComponent = characterView.get<MovementComponent>(entity);
-        auto& cellIdComponent = characterView.get<CellIdComponent>(entity);
-        auto& ownerComponent = characterView.get<OwnerComponent>(entity);
-        auto& animationComponent = characterView.get<AnimationComponent>(entity);
+    // The world is read only until every recipient is done, each one is assembled and encoded on its own
+    m_world.GetJobPool().ParallelFor(recipients.size(), [&](size_t aIndex) {
+        static thread_local ScratchAllocator s_allocator{ 1 << 18 };
 
-        // If we have nothing new to send skip this
-        if (movementComponent.Sent == true)
-            continue;
+        auto& encoded = m_encodedMovements[aIndex];
+        encoded.Data.clear();
 
-        for (auto player : playerView)
         {
-            const auto& playerComponent = playerView.get<PlayerComponent>(player);
+            ScopedAllocator _{ s_allocator };
 
-            if (playerView.get<CellIdComponent>(player) != cellIdComponent || playerComponent.ConnectionId == ownerComponent.ConnectionId)
-                continue;
-
-            auto& message = messages[playerComponent.ConnectionId];
-            auto& update = message.Updates[World::ToInteger(entity)];
-            auto& movement = update.UpdatedMovement;
+            ServerReferencesMoveRequest message;
+            message.Tick = cTick;
 
-            movement.Position = movementComponent.Position;
+            m_movementReplication.Assemble(playerView.get<PlayerComponent>(recipients[aIndex]).ConnectionId,
+                                           playerView.get<CellIdComponent>(recipients[aIndex]).Cell, message);
 
-            movement.Rotation.x = movementComponent.Rotation.x;
-            movement.Rotation.y = movementComponent.Rotation.z;
-
-            movement.Direction = movementComponent.Direction;
-            movement.Variables = movementComponent.Variables;
-
-            update.ActionEvents = animationComponent.Actions;
+            if (!message.Updates.empty())
+                GameServer::Encode(message, encoded);
         }
-    }
 
-    m_world.view<AnimationComponent>().each([](AnimationComponent& animationComponent)
-        {
-            if (!animationComponent.Actions.empty())
-                animationComponent.LastSerializedAction = animationComponent.Actions[animationComponent.Actions.size() - 1];
+        s_allocator.Reset();
+    });
 
-            animationComponent.Actions.clear();
-        });
-
-    m_world.view<MovementComponent>().each([](MovementComponent& movementComponent)
-        {
-            movementComponent.Sent = true;
-        });
-
-    for (auto [connectionId, message] : messages)
+    for (size_t i = 0; i < recipients.size(); ++i)
     {
-        if (!message.Updates.empty())
-            GameServer::Get()->Send(connectionId, message);
+        if (!m_encodedMovements[i].Data.empty())
+            GameServer::Get()->SendEncoded(playerView.get<PlayerComponent>(recipients[i]).ConnectionId, m_encodedMovements[i]);
     }
 }
@@ -1,8 +1,9 @@
 #pragma once
 
 #include <Events/PacketEvent.h>
+#include <EncodedMessage.h>
+#include <MovementReplication.h>
 
-struct UpdateEvent;
 struct CharacterCellChangeEvent;
 struct CharacterSpawnedEvent;
 struct World;
@@ -22,32 +23,56 @@ struct CharacterService
 
     TP_NOCOPYMOVE(CharacterService);
 
-    static void Serialize(const World& aRegistry, entt::entity aEntity, CharacterSpawnRequest* apSpawnRequest) noexcept;
+    // The state part of the spawn is encoded once per entity and reused until one of the component versions changes
+    static void Serialize(World& aRegistry, entt::entity aEntity, CharacterSpawnRequest* apSpawnRequest) noexcept;
+
+    // Number of movement samples kept per actor for lag compensation, 0 disables the history
+    void SetMovementHistoryLength(uint32_t aLength) noexcept;
+    [[nodiscard]] uint32_t GetMovementHistoryLength() const noexcept { return m_movementHistoryLength; }
+
+    // Queues the entity for the next replication pass, passes only visit what was marked since the last one
+    void MarkMovementDirty(entt::entity aEntity) noexcept;
+    void MarkInventoryDirty(entt::entity aEntity) noexcept;
+    void MarkFactionsDirty(entt::entity aEntity) noexcept;
 
 protected:
 
-    void OnUpdate(const UpdateEvent& acEvent) const noexcept;
     void OnCharacterCellChange(const CharacterCellChangeEvent& acEvent) const noexcept;
-    void OnAssignCharacterRequest(const PacketEvent<AssignCharacterRequest>& acMessage) const noexcept;
+    void OnAssignCharacterRequest(const PacketEvent<AssignCharacterRequest>& acMessage) noexcept;
     void OnRemoveCharacterRequest(const PacketEvent<RemoveCharacterRequest>& acMessage) const noexcept;
     void OnCharacterSpawned(const CharacterSpawnedEvent& acEvent) const noexcept;
-    void OnReferencesMoveRequest(const PacketEvent<ClientReferencesMoveRequest>& acMessage) const noexcept;
-    void OnInventoryChanges(const PacketEvent<RequestInventoryChanges>& acMessage) const noexcept;
-    void OnFactionsChanges(const PacketEvent<RequestFactionsChanges>& acMessage) const noexcept;
+    void OnReferencesMoveRequest(const PacketEvent<ClientReferencesMoveRequest>& acMessage) noexcept;
+    void OnInventoryChanges(const PacketEvent<RequestInventoryChanges>& acMessage) noexcept;
+    void OnFactionsChanges(const PacketEvent<RequestFactionsChanges>& acMessage) noexcept;
     void OnCharacterTravel(const PacketEvent<CharacterTravelRequest>& acMessage) const noexcept;
     void OnRequestSpawnData(const PacketEvent<RequestSpawnData>& acMessage) const noexcept;
 
-    void CreateCharacter(const PacketEvent<AssignCharacterRequest>& acMessage) const noexcept;
+    void CreateCharacter(const PacketEvent<AssignCharacterRequest>& acMessage) noexcept;
 
-    void ProcessInventoryChanges() const noexcept;
-    void ProcessFactionsChanges() const noexcept;
-    void ProcessMovementChanges() const noexcept;
+    static void EncodeSpawn(World& aRegistry, entt::entity aEntity, EncodedMessage& aMessage) noexcept;
+    [[nodiscard]] static std::shared_ptr<const std::vector<uint8_t>> GetEncodedState(World& aRegistry, entt::entity aEntity) noexcept;
+
+    void ProcessInventoryChanges() noexcept;
+    void ProcessFactionsChanges() noexcept;
+    void ProcessMovementChanges() noexcept;
 
 private:
 
     World& m_world;
 
-    entt::scoped_connection m_updateConnection;
+    uint32_t m_movementHistoryLength{ 32 };
+
+    // The component flags make sure an entity is only queued once per pass
+    Vector<entt::entity> m_dirtyMovements;
+    Vector<entt::entity> m_dirtyInventories;
+    Vector<entt::entity> m_dirtyFactions;
+
+    // Entities that moved since the last pass
+    MovementReplication m_movementReplication;
+
+    // One encoded ServerReferencesMoveRequest per recipient, kept around to reuse the allocations
+    std::vector<EncodedMessage> m_encodedMovements;
+
     entt::scoped_connection m_characterCellChangeEventConnection;
     entt::scoped_connection m_characterAssignRequestConnection;
     entt::scoped_connection m_removeChatacterConnection;
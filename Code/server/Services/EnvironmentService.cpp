@@ -4,42 +4,41 @@
 #include <GameServer.h>
 
 #include <Services/EnvironmentService.h>
-#include <Events/UpdateEvent.h>
 #include <Events/PlayerJoinEvent.h>
-#include <Messages/ServerTimeSettings.h>
 #include <Components.h>
 
 EnvironmentService::EnvironmentService(World &aWorld, entt::dispatcher &aDispatcher) : m_world(aWorld)
 {
-    m_updateConnection = aDispatcher.sink<UpdateEvent>().connect<&EnvironmentService::OnUpdate>(this);
     m_joinConnection = aDispatcher.sink<PlayerJoinEvent>().connect<&EnvironmentService::OnPlayerJoin>(this);
 }
 
 void EnvironmentService::OnPlayerJoin(const PlayerJoinEvent& acEvent) const noexcept
+{
+    const auto &playerComponent = m_world.get<PlayerComponent>(acEvent.Entity);
+    GameServer::Get()->Send(playerComponent.ConnectionId, BuildTimeSettings());
+}
+
+ServerTimeSettings EnvironmentService::BuildTimeSettings() const noexcept
 {
     ServerTimeSettings timeMsg;
-    timeMsg.TimeScale = m_timeModel.TimeScale;
-    timeMsg.Time = m_timeModel.Time;
+    timeMsg.GameTime = m_timeModel.GameTime;
+    timeMsg.EpochTick = m_timeModel.EpochTick;
+    timeMsg.Rate = m_timeModel.Rate;
 
-    const auto &playerComponent = m_world.get<PlayerComponent>(acEvent.Entity);
-    GameServer::Get()->Send(playerComponent.ConnectionId, timeMsg);
+    return timeMsg;
 }
 
 bool EnvironmentService::SetTime(int aHours, int aMinutes, float aScale) noexcept
 {
-    m_timeModel.TimeScale = aScale;
-
-    if (aHours >= 0 && aHours <= 24 && aMinutes >= 0 && aMinutes <= 60)
+    if (aHours >= 0 && aHours < 24 && aMinutes >= 0 && aMinutes < 60)
     {
-        // encode time as skyrim time
-        auto minutes = static_cast<float>(aMinutes) * 0.17f;
-        minutes = floor(minutes * 100) / 1000;
-        m_timeModel.Time = static_cast<float>(aHours) + minutes;
-
-        ServerTimeSettings timeMsg;
-        timeMsg.TimeScale = m_timeModel.TimeScale;
-        timeMsg.Time = m_timeModel.Time;
-        GameServer::Get()->SendToLoaded(timeMsg);
+        const auto cTick = GameServer::Get()->GetTick();
+        const auto cTimeOfDay = aHours * TimeModel::kHourLength + aMinutes * TimeModel::kMinuteLength;
+
+        m_timeModel.SetTimeScale(aScale, cTick);
+        m_timeModel.SetTimeOfDay(cTimeOfDay, cTick);
+
+        GameServer::Get()->SendToLoaded(BuildTimeSettings());
         return true;
     }
 
@@ -48,11 +47,11 @@ bool EnvironmentService::SetTime(int aHours, int aMinutes, float aScale) noexcep
 
 EnvironmentService::TTime EnvironmentService::GetTime() const noexcept
 {
-    const auto hour = floor(m_timeModel.Time);
-    const auto minutes = (m_timeModel.Time - hour) / 17.f;
+    const auto cTimeOfDay = m_timeModel.GetTimeOfDay(GameServer::Get()->GetTick());
 
-    const auto flatMinutes = static_cast<int>(ceil((minutes * 100.f) * 10.f));
-    return {static_cast<int>(hour), flatMinutes};
+    const auto hours = static_cast<int>(cTimeOfDay / TimeModel::kHourLength);
+    const auto minutes = static_cast<int>((cTimeOfDay % TimeModel::kHourLength) / TimeModel::kMinuteLength);
+    return {hours, minutes};
 }
 
 EnvironmentService::TTime EnvironmentService::GetRealTime() noexcept
@@ -65,21 +64,20 @@ EnvironmentService::TTime EnvironmentService::GetRealTime() noexcept
 
 EnvironmentService::TDate EnvironmentService::GetDate() const noexcept
 {
-    return {m_timeModel.Day, m_timeModel.Month, m_timeModel.Year};
+    const auto date = m_timeModel.GetDate(GameServer::Get()->GetTick());
+    return {date.Day, date.Month, date.Year};
 }
 
-void EnvironmentService::OnUpdate(const UpdateEvent &) noexcept
+uint64_t EnvironmentService::GetGameTime() const noexcept
 {
-    if (!m_lastTick)
-        m_lastTick = GameServer::Get()->GetTick();
-
-    auto now = GameServer::Get()->GetTick();
+    return m_timeModel.GetGameTime(GameServer::Get()->GetTick());
+}
 
-    // client got ahead, we wait
-    if (now < m_lastTick)
-        return;
+void EnvironmentService::RestoreTime(uint64_t aGameTime, uint32_t aRate) noexcept
+{
+    m_timeModel.GameTime = aGameTime;
+    m_timeModel.EpochTick = GameServer::Get()->GetTick();
+    m_timeModel.Rate = aRate;
 
-    auto delta = now - m_lastTick;
-    m_lastTick = now;
-    m_timeModel.Update(delta);
+    GameServer::Get()->SendToLoaded(BuildTimeSettings());
 }
@@ -2,9 +2,9 @@
 
 #include <Events/PacketEvent.h>
 #include <Structs/TimeModel.h>
+#include <Messages/ServerTimeSettings.h>
 
 struct World;
-struct UpdateEvent;
 struct PlayerJoinEvent;
 
 class EnvironmentService
@@ -27,16 +27,21 @@ public:
     // returns dd/mm/yy
     TDate GetDate() const noexcept;
 
-    float GetTimeScale() const noexcept { return m_timeModel.TimeScale; }
+    float GetTimeScale() const noexcept { return m_timeModel.GetTimeScale(); }
+
+    // Game milliseconds elapsed since 01/01/01 00:00
+    uint64_t GetGameTime() const noexcept;
+    const TimeModel& GetTimeModel() const noexcept { return m_timeModel; }
+    void RestoreTime(uint64_t aGameTime, uint32_t aRate) noexcept;
 
 private:
-    void OnUpdate(const UpdateEvent &) noexcept; 
     void OnPlayerJoin(const PlayerJoinEvent&) const noexcept;
 
+    [[nodiscard]] ServerTimeSettings BuildTimeSettings() const noexcept;
+
+    // Clients extrapolate from the model, it only needs to be sent when it changes
     TimeModel m_timeModel;
-    uint64_t m_lastTick = 0;
 
-    entt::scoped_connection m_updateConnection;
     entt::scoped_connection m_joinConnection;
     World &m_world;
 };
@@ -6,24 +6,33 @@
 
 #include <Events/PlayerJoinEvent.h>
 #include <Events/PlayerLeaveEvent.h>
-#include <Events/UpdateEvent.h>
 
 #include <Messages/NotifyPlayerList.h>
+#include <Messages/NotifyPlayerJoined.h>
+#include <Messages/NotifyPlayerLeft.h>
 #include <Messages/NotifyPartyInfo.h>
 #include <Messages/NotifyPartyInvite.h>
 #include <Messages/PartyInviteRequest.h>
 #include <Messages/PartyAcceptInviteRequest.h>
 #include <Messages/PartyLeaveRequest.h>
 
+namespace
+{
+// Members in the same cell are refreshed every pass, the others every cFarMemberStatesDivider passes
+constexpr auto cMemberStatesInterval = 200ms;
+constexpr uint32_t cFarMemberStatesDivider = 5;
+constexpr std::chrono::milliseconds cInvitationLifetime = 60s;
+}
+
 PartyService::PartyService(World& aWorld, entt::dispatcher& aDispatcher) noexcept
     : m_world(aWorld)
-    , m_updateEvent(aDispatcher.sink<UpdateEvent>().connect<&PartyService::OnUpdate>(this))
     , m_playerJoinConnection(aDispatcher.sink<PlayerJoinEvent>().connect<&PartyService::OnPlayerJoin>(this))
     , m_playerLeaveConnection(aDispatcher.sink<PlayerLeaveEvent>().connect<&PartyService::OnPlayerLeave>(this))
     , m_partyInviteConnection(aDispatcher.sink<PacketEvent<PartyInviteRequest>>().connect<&PartyService::OnPartyInvite>(this))
     , m_partyAcceptInviteConnection(aDispatcher.sink<PacketEvent<PartyAcceptInviteRequest>>().connect<&PartyService::OnPartyAcceptInvite>(this))
     , m_partyLeaveConnection(aDispatcher.sink<PacketEvent<PartyLeaveRequest>>().connect<&PartyService::OnPartyLeave>(this))
 {
+    aWorld.GetTimerService().SetInterval(cMemberStatesInterval, [this]() { SendMemberStates(); });
 }
 
 const PartyService::Party* PartyService::GetById(uint32_t aId) const noexcept
@@ -35,43 +44,25 @@ const PartyService::Party* PartyService::GetById(uint32_t aId) const noexcept
     return nullptr;
 }
 
-void PartyService::OnUpdate(const UpdateEvent& acEvent) noexcept
+void PartyService::RestoreParty(Vector<String> aMemberKeys) noexcept
 {
-    const auto cCurrentTick = GameServer::Get()->GetTick();
-    if (m_nextInvitationExpire > cCurrentTick)
-        return;
-
-    // Only expire once every 10 seconds
-    m_nextInvitationExpire = cCurrentTick + 10000;
-
-    auto view = m_world.view<PartyComponent>();
-    for (auto entity : view)
-    {
-        auto& partyComponent = view.get<PartyComponent>(entity);
-        auto itor = std::begin(partyComponent.Invitations);
-        while (itor != std::end(partyComponent.Invitations))
-        {
-            if (itor->second < cCurrentTick)
-            {
-                itor = partyComponent.Invitations.erase(itor);
-            }
-            else
-            {
-                ++itor;
-            }
-        }
-    }
+    m_restoredParties.push_back({std::move(aMemberKeys), std::nullopt});
 }
 
-void PartyService::OnPlayerJoin(const PlayerJoinEvent& acEvent) const noexcept
+void PartyService::OnPlayerJoin(const PlayerJoinEvent& acEvent) noexcept
 {
     // When a player joins give it a party component for later
-    m_world.emplace<PartyComponent>(acEvent.Entity);
+    auto& partyComponent = m_world.emplace<PartyComponent>(acEvent.Entity);
+
+    JoinRestoredParty(acEvent.Entity, partyComponent);
 
-    BroadcastPlayerList();
+    ++m_playerListVersion;
+
+    SendPlayerList(acEvent.Entity);
+    BroadcastPlayerJoined(acEvent.Entity);
 }
 
-void PartyService::OnPartyInvite(const PacketEvent<PartyInviteRequest>& acPacket) const noexcept
+void PartyService::OnPartyInvite(const PacketEvent<PartyInviteRequest>& acPacket) noexcept
 {
     auto& message = acPacket.Packet;
 
@@ -93,10 +84,20 @@ void PartyService::OnPartyInvite(const PacketEvent<PartyInviteRequest>& acPacket
     {
         auto& otherPartyComponent = view.get<PartyComponent>(*otherItor);
 
-        // Expire in 60 seconds
-        const auto cExpiryTick = GameServer::Get()->GetTick() + 60000;
+        const auto cExpiryTick = GameServer::Get()->GetTick() + cInvitationLifetime.count();
         otherPartyComponent.Invitations[*selfItor] = cExpiryTick;
 
+        // Accepted invitations are gone and renewed ones have a later expiry by the time this runs, both are left alone
+        m_world.GetTimerService().SetTimeout(cInvitationLifetime, [this, invitee = *otherItor, inviter = *selfItor, cExpiryTick]() {
+            auto* pPartyComponent = m_world.valid(invitee) ? m_world.try_get<PartyComponent>(invitee) : nullptr;
+            if (!pPartyComponent)
+                return;
+
+            auto itor = pPartyComponent->Invitations.find(inviter);
+            if (itor != std::end(pPartyComponent->Invitations) && itor->second == cExpiryTick)
+                pPartyComponent->Invitations.erase(itor);
+        });
+
         NotifyPartyInvite notification;
         notification.InviterId = World::ToInteger(*selfItor);
         notification.ExpiryTick = cExpiryTick;
@@ -180,7 +181,9 @@ void PartyService::OnPlayerLeave(const PlayerLeaveEvent& acEvent) noexcept
 {
     RemovePlayerFromParty(acEvent.Entity);
 
-    BroadcastPlayerList(acEvent.Entity);
+    ++m_playerListVersion;
+
+    BroadcastPlayerLeft(acEvent.Entity);
 }
 
 void PartyService::RemovePlayerFromParty(entt::entity aEntity) noexcept
@@ -211,34 +214,89 @@ void PartyService::RemovePlayerFromParty(entt::entity aEntity) noexcept
     }
 }
 
-void PartyService::BroadcastPlayerList(std::optional<entt::entity> aSkipEntity) const noexcept
+void PartyService::JoinRestoredParty(entt::entity aEntity, PartyComponent& aPartyComponent) noexcept
+{
+    if (m_restoredParties.empty())
+        return;
+
+    const auto cKey = m_world.get<PlayerComponent>(aEntity).GetPersistentKey();
+
+    for (auto& restoredParty : m_restoredParties)
+    {
+        auto& keys = restoredParty.MemberKeys;
+        if (std::find(std::begin(keys), std::end(keys), cKey) == std::end(keys))
+            continue;
+
+        // The first member to come back recreates the party, or recreates it again if everyone left in between
+        if (!restoredParty.Id || m_parties.count(*restoredParty.Id) == 0)
+            restoredParty.Id = m_nextId++;
+
+        m_parties[*restoredParty.Id].Members.push_back(aEntity);
+        aPartyComponent.JoinedPartyId = *restoredParty.Id;
+
+        BroadcastPartyInfo(*restoredParty.Id);
+        return;
+    }
+}
+
+void PartyService::SendPlayerList(entt::entity aPlayer) const noexcept
 {
     auto playerView = m_world.view<const PlayerComponent>();
 
-    for (auto player : playerView)
+    const auto* pPlayerComponent = m_world.try_get<PlayerComponent>(aPlayer);
+    if (!pPlayerComponent)
+        return;
+
+    // The full list only goes to the player that just joined, everyone else gets a delta
+    NotifyPlayerList playerList;
+    playerList.Version = m_playerListVersion;
+
+    for (auto otherPlayer : playerView)
     {
-        if (aSkipEntity && *aSkipEntity == player)
+        if (otherPlayer == aPlayer)
             continue;
 
-        NotifyPlayerList playerList;
+        playerList.Players[World::ToInteger(otherPlayer)] = playerView.get<const PlayerComponent>(otherPlayer).Username;
+    }
 
-        auto& currentPlayerComponent = playerView.get<const PlayerComponent>(player);
+    GameServer::Get()->Send(pPlayerComponent->ConnectionId, playerList);
+}
 
-        for (auto otherPlayer : playerView)
-        {
-            if (player == otherPlayer)
-                continue;
+void PartyService::BroadcastPlayerJoined(entt::entity aPlayer) const noexcept
+{
+    const auto* pPlayerComponent = m_world.try_get<PlayerComponent>(aPlayer);
+    if (!pPlayerComponent)
+        return;
 
-            if (aSkipEntity && *aSkipEntity == otherPlayer)
-                continue;
+    NotifyPlayerJoined message;
+    message.Version = m_playerListVersion;
+    message.PlayerId = World::ToInteger(aPlayer);
+    message.Username = pPlayerComponent->Username;
 
-            auto& otherPlayerComponent = playerView.get<const PlayerComponent>(otherPlayer);
+    auto playerView = m_world.view<const PlayerComponent>();
+    for (auto player : playerView)
+    {
+        if (player == aPlayer)
+            continue;
 
-            playerList.Players[World::ToInteger(otherPlayer)] = otherPlayerComponent.Username;
-        }
+        GameServer::Get()->Send(playerView.get<const PlayerComponent>(player).ConnectionId, message);
+    }
+}
+
+void PartyService::BroadcastPlayerLeft(entt::entity aPlayer) const noexcept
+{
+    NotifyPlayerLeft message;
+    message.Version = m_playerListVersion;
+    message.PlayerId = World::ToInteger(aPlayer);
+
+    auto playerView = m_world.view<const PlayerComponent>();
+    for (auto player : playerView)
+    {
+        if (player == aPlayer)
+            continue;
 
-        GameServer::Get()->Send(currentPlayerComponent.ConnectionId, playerList);
-    }    
+        GameServer::Get()->Send(playerView.get<const PlayerComponent>(player).ConnectionId, message);
+    }
 }
 
 void PartyService::BroadcastPartyInfo(uint32_t aPartyId) const noexcept
@@ -265,3 +323,74 @@ void PartyService::BroadcastPartyInfo(uint32_t aPartyId) const noexcept
         GameServer::Get()->Send(pPlayerComponent->ConnectionId, message);
     }
 }
+
+void PartyService::SendMemberStates() noexcept
+{
+    const bool cFarPass = (m_memberStatesPass++ % cFarMemberStatesDivider) == 0;
+
+    for (const auto& entry : m_parties)
+    {
+        const auto& members = entry.second.Members;
+        if (members.size() < 2)
+            continue;
+
+        // Gather each member's state once, every other member of the party reads it
+        m_memberEntries.clear();
+        for (auto member : members)
+        {
+            auto& memberEntry = m_memberEntries.emplace_back();
+
+            const auto* pPlayerComponent = m_world.try_get<PlayerComponent>(member);
+            if (!pPlayerComponent)
+                continue;
+
+            memberEntry.ConnectionId = pPlayerComponent->ConnectionId;
+
+            if (!pPlayerComponent->Character || !m_world.valid(*pPlayerComponent->Character))
+                continue;
+
+            const auto cCharacter = *pPlayerComponent->Character;
+            const auto* pMovementComponent = m_world.try_get<MovementComponent>(cCharacter);
+            const auto* pCellIdComponent = m_world.try_get<CellIdComponent>(cCharacter);
+            if (!pMovementComponent || !pCellIdComponent)
+                continue;
+
+            auto& state = memberEntry.State.emplace();
+            state.PlayerId = World::ToInteger(member);
+            state.CellId = pCellIdComponent->Cell;
+            state.Position.x = pMovementComponent->Position.x;
+            state.Position.y = pMovementComponent->Position.y;
+            state.Position.z = pMovementComponent->Position.z;
+
+            if (auto* pActorValuesComponent = m_world.try_get<ActorValuesComponent>(cCharacter))
+            {
+                auto& actorValues = pActorValuesComponent->CurrentActorValues;
+                if (actorValues.ActorValuesList.contains(ActorValuesComponent::kHealthId))
+                    state.Health = actorValues.ActorValuesList[ActorValuesComponent::kHealthId];
+                if (actorValues.ActorMaxValuesList.contains(ActorValuesComponent::kHealthId))
+                    state.MaxHealth = actorValues.ActorMaxValuesList[ActorValuesComponent::kHealthId];
+            }
+        }
+
+        for (auto i = 0u; i < m_memberEntries.size(); ++i)
+        {
+            const auto& recipient = m_memberEntries[i];
+            if (!recipient.State)
+                continue;
+
+            NotifyPartyMemberStates message;
+            for (auto j = 0u; j < m_memberEntries.size(); ++j)
+            {
+                const auto& other = m_memberEntries[j];
+                if (i == j || !other.State)
+                    continue;
+
+                if (cFarPass || other.State->CellId == recipient.State->CellId)
+                    message.Members.push_back(*other.State);
+            }
+
+            if (!message.Members.empty())
+                GameServer::Get()->Send(recipient.ConnectionId, message);
+        }
+    }
+}
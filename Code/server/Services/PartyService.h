@@ -1,14 +1,15 @@
 #pragma once
 
 #include <Events/PacketEvent.h>
+#include <Messages/NotifyPartyMemberStates.h>
 
 struct World;
-struct UpdateEvent;
 struct PlayerJoinEvent;
 struct PlayerLeaveEvent;
 struct PartyInviteRequest;
 struct PartyAcceptInviteRequest;
 struct PartyLeaveRequest;
+struct PartyComponent;
 
 struct PartyService
 {
@@ -23,30 +24,51 @@ struct PartyService
     TP_NOCOPYMOVE(PartyService);
 
     const Party* GetById(uint32_t aId) const noexcept;
+    const Map<uint32_t, Party>& GetParties() const noexcept { return m_parties; }
+
+    // Parties loaded from a snapshot, members are grouped again as they reconnect
+    void RestoreParty(Vector<String> aMemberKeys) noexcept;
 
 protected:
 
-    void OnUpdate(const UpdateEvent& acEvent) noexcept;
-    void OnPlayerJoin(const PlayerJoinEvent& acEvent) const noexcept;
+    void OnPlayerJoin(const PlayerJoinEvent& acEvent) noexcept;
     void OnPlayerLeave(const PlayerLeaveEvent& acEvent) noexcept;
-    void OnPartyInvite(const PacketEvent<PartyInviteRequest>& acPacket) const noexcept;
+    void OnPartyInvite(const PacketEvent<PartyInviteRequest>& acPacket) noexcept;
     void OnPartyAcceptInvite(const PacketEvent<PartyAcceptInviteRequest>& acPacket) noexcept;
     void OnPartyLeave(const PacketEvent<PartyLeaveRequest>& acPacket) noexcept;
 
     void RemovePlayerFromParty(entt::entity aEntity) noexcept;
+    void JoinRestoredParty(entt::entity aEntity, PartyComponent& aPartyComponent) noexcept;
 
-    void BroadcastPlayerList(std::optional<entt::entity> aSkipEntity = std::nullopt) const noexcept;
+    void SendPlayerList(entt::entity aPlayer) const noexcept;
+    void BroadcastPlayerJoined(entt::entity aPlayer) const noexcept;
+    void BroadcastPlayerLeft(entt::entity aPlayer) const noexcept;
     void BroadcastPartyInfo(uint32_t aPartyId) const noexcept;
+    void SendMemberStates() noexcept;
 
 private:
 
+    struct MemberEntry
+    {
+        ConnectionId_t ConnectionId;
+        std::optional<NotifyPartyMemberStates::MemberState> State;
+    };
+
+    struct RestoredParty
+    {
+        Vector<String> MemberKeys;
+        std::optional<uint32_t> Id;
+    };
+
     World& m_world;
 
     Map<uint32_t, Party> m_parties;
+    Vector<RestoredParty> m_restoredParties;
     uint32_t m_nextId{0};
-    uint64_t m_nextInvitationExpire{0};
+    uint32_t m_playerListVersion{0};
+    uint32_t m_memberStatesPass{0};
+    Vector<MemberEntry> m_memberEntries;
 
-    entt::scoped_connection m_updateEvent;
     entt::scoped_connection m_playerJoinConnection;
     entt::scoped_connection m_playerLeaveConnection;
     entt::scoped_connection m_partyInviteConnection;
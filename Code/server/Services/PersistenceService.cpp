@@ -0,0 +1,504 @@
+#include <stdafx.h>
+
+#include <Services/PersistenceService.h>
+#include <Services/QuestService.h>
+#include <Components.h>
+#include <World.h>
+
+#include <Events/UpdateEvent.h>
+#include <Events/PlayerJoinEvent.h>
+#include <Events/PlayerLeaveEvent.h>
+#include <Events/PlayerEnterWorldEvent.h>
+
+#include <Messages/RequestInventoryChanges.h>
+#include <Messages/RequestFactionsChanges.h>
+#include <Messages/RequestQuestUpdate.h>
+#include <Messages/RequestActorValueChanges.h>
+#include <Messages/RequestActorMaxValueChanges.h>
+
+#include <sqlite3.h>
+
+namespace
+{
+constexpr auto cFlushInterval = 5s;
+
+const char* s_schema =
+    "PRAGMA journal_mode=WAL;"
+    "PRAGMA synchronous=NORMAL;"
+    "CREATE TABLE IF NOT EXISTS players (key TEXT PRIMARY KEY, quests BLOB, inventory BLOB, actor_values BLOB, character BLOB, updated INTEGER);"
+    "CREATE TABLE IF NOT EXISTS mods (filename TEXT PRIMARY KEY, lite INTEGER NOT NULL, id INTEGER NOT NULL);";
+
+template<class T>
+std::string Encode(const T& acValue) noexcept
+{
+    Buffer buffer(1 << 16);
+    Buffer::Writer writer(&buffer);
+
+    acValue.Serialize(writer);
+
+    return std::string(reinterpret_cast<const char*>(buffer.GetData()), writer.Size());
+}
+
+template<class T>
+void Decode(const std::string& acData, T& aValue) noexcept
+{
+    if (acData.empty())
+        return;
+
+    Buffer buffer(reinterpret_cast<const uint8_t*>(acData.data()), acData.size());
+    Buffer::Reader reader(&buffer);
+
+    aValue.Deserialize(reader);
+}
+
+std::string EncodeCharacter(const CharacterComponent& acCharacterComponent) noexcept
+{
+    Buffer buffer(1 << 16);
+    Buffer::Writer writer(&buffer);
+
+    Serialization::WriteVarInt(writer, acCharacterComponent.ChangeFlags);
+    Serialization::WriteString(writer, acCharacterComponent.SaveBuffer);
+    acCharacterComponent.FaceTints.Serialize(writer);
+    acCharacterComponent.FactionsContent.Serialize(writer);
+
+    return std::string(reinterpret_cast<const char*>(buffer.GetData()), writer.Size());
+}
+
+void DecodeCharacter(const std::string& acData, CharacterComponent& aCharacterComponent) noexcept
+{
+    if (acData.empty())
+        return;
+
+    Buffer buffer(reinterpret_cast<const uint8_t*>(acData.data()), acData.size());
+    Buffer::Reader reader(&buffer);
+
+    aCharacterComponent.ChangeFlags = Serialization::ReadVarInt(reader) & 0xFFFFFFFF;
+    aCharacterComponent.SaveBuffer = Serialization::ReadString(reader);
+    aCharacterComponent.FaceTints.Deserialize(reader);
+    aCharacterComponent.FactionsContent.Deserialize(reader);
+}
+
+std::string ReadBlob(sqlite3_stmt* apStatement, int aColumn) noexcept
+{
+    const auto* pData = static_cast<const char*>(sqlite3_column_blob(apStatement, aColumn));
+    const auto size = sqlite3_column_bytes(apStatement, aColumn);
+
+    return pData ? std::string(pData, size) : std::string{};
+}
+}
+
+PersistenceService::PersistenceService(World& aWorld, entt::dispatcher& aDispatcher) noexcept
+    : m_world(aWorld)
+    , m_updateConnection(aDispatcher.sink<UpdateEvent>().connect<&PersistenceService::OnUpdate>(this))
+    , m_playerJoinConnection(aDispatcher.sink<PlayerJoinEvent>().connect<&PersistenceService::OnPlayerJoin>(this))
+    , m_playerLeaveConnection(aDispatcher.sink<PlayerLeaveEvent>().connect<&PersistenceService::OnPlayerLeave>(this))
+    , m_playerEnterWorldConnection(aDispatcher.sink<PlayerEnterWorldEvent>().connect<&PersistenceService::OnPlayerEnterWorld>(this))
+    , m_inventoryChangesConnection(aDispatcher.sink<PacketEvent<RequestInventoryChanges>>().connect<&PersistenceService::OnStateChange<RequestInventoryChanges>>(this))
+    , m_factionsChangesConnection(aDispatcher.sink<PacketEvent<RequestFactionsChanges>>().connect<&PersistenceService::OnStateChange<RequestFactionsChanges>>(this))
+    , m_questUpdateConnection(aDispatcher.sink<PacketEvent<RequestQuestUpdate>>().connect<&PersistenceService::OnStateChange<RequestQuestUpdate>>(this))
+    , m_actorValueChangesConnection(aDispatcher.sink<PacketEvent<RequestActorValueChanges>>().connect<&PersistenceService::OnStateChange<RequestActorValueChanges>>(this))
+    , m_actorMaxValueChangesConnection(aDispatcher.sink<PacketEvent<RequestActorMaxValueChanges>>().connect<&PersistenceService::OnStateChange<RequestActorMaxValueChanges>>(this))
+{
+}
+
+PersistenceService::~PersistenceService() noexcept
+{
+    if (!m_pDatabase)
+        return;
+
+    {
+        std::scoped_lock _(m_lock);
+        m_running = false;
+    }
+
+    m_wakeup.notify_one();
+
+    if (m_thread.joinable())
+        m_thread.join();
+
+    sqlite3_close(m_pDatabase);
+}
+
+bool PersistenceService::Initialize(const String& acPath) noexcept
+{
+    if (sqlite3_open(acPath.c_str(), &m_pDatabase) != SQLITE_OK)
+    {
+        spdlog::error("Unable to open the world state store {}: {}", acPath.c_str(), sqlite3_errmsg(m_pDatabase));
+
+        sqlite3_close(m_pDatabase);
+        m_pDatabase = nullptr;
+
+        return false;
+    }
+
+    char* pError = nullptr;
+    if (sqlite3_exec(m_pDatabase, s_schema, nullptr, nullptr, &pError) != SQLITE_OK)
+    {
+        spdlog::error("Unable to create the world state schema: {}", pError);
+
+        sqlite3_free(pError);
+        sqlite3_close(m_pDatabase);
+        m_pDatabase = nullptr;
+
+        return false;
+    }
+
+    // Done before any player connects, form ids stored in records are only meaningful with the same mod ids
+    LoadMods();
+
+    m_running = true;
+    m_thread = std::thread(&PersistenceService::Run, this);
+
+    m_world.GetTimerService().SetInterval(cFlushInterval, [this]() { Flush(); });
+
+    spdlog::info("Persisting world state to {}", acPath.c_str());
+
+    return true;
+}
+
+void PersistenceService::OnUpdate(const UpdateEvent& acEvent) noexcept
+{
+    if (!IsEnabled())
+        return;
+
+    std::vector<Load> completedLoads;
+    {
+        std::scoped_lock _(m_lock);
+        std::swap(completedLoads, m_completedLoads);
+    }
+
+    for (auto& load : completedLoads)
+    {
+        if (!m_world.valid(load.Player))
+            continue;
+
+        const auto* pPlayerComponent = m_world.try_get<PlayerComponent>(load.Player);
+
+        // The entity could have been recycled by another player while the store was being read
+        if (!pPlayerComponent || GetKey(*pPlayerComponent) != load.Key)
+            continue;
+
+        // Nothing stored yet, whatever the player has from now on is theirs to save
+        if (!load.Result)
+        {
+            m_loadedPlayers.insert(load.Player);
+            continue;
+        }
+
+        if (pPlayerComponent->Character)
+            Restore(load.Player, *load.Result);
+        else
+            m_awaitingCharacter[load.Player] = std::move(*load.Result);
+    }
+}
+
+void PersistenceService::OnPlayerJoin(const PlayerJoinEvent& acEvent) noexcept
+{
+    if (!IsEnabled())
+        return;
+
+    const auto& playerComponent = m_world.get<PlayerComponent>(acEvent.Entity);
+    auto& mods = m_world.ctx<ModsComponent>();
+
+    std::vector<ModRecord> modRecords;
+    modRecords.reserve(playerComponent.ModIds.size());
+
+    for (auto id : playerComponent.ModIds)
+    {
+        const auto* pEntry = mods.Get(id);
+        if (!pEntry)
+            continue;
+
+        // Persisted form ids refer to this id from now on
+        mods.Pin(id);
+        modRecords.push_back({std::string(pEntry->Filename.c_str(), pEntry->Filename.size()), id, pEntry->Lite});
+    }
+
+    {
+        std::scoped_lock _(m_lock);
+
+        m_pendingMods.insert(std::end(m_pendingMods), std::begin(modRecords), std::end(modRecords));
+        m_pendingLoads.push_back({acEvent.Entity, GetKey(playerComponent), std::nullopt});
+    }
+
+    m_wakeup.notify_one();
+}
+
+void PersistenceService::OnPlayerLeave(const PlayerLeaveEvent& acEvent) noexcept
+{
+    if (!IsEnabled())
+        return;
+
+    m_awaitingCharacter.erase(acEvent.Entity);
+
+    // Components are destroyed right after this event, write them now regardless of the flush timer
+    Enqueue(acEvent.Entity);
+    m_loadedPlayers.erase(acEvent.Entity);
+
+    if (const auto* pPlayerComponent = m_world.try_get<PlayerComponent>(acEvent.Entity))
+        m_dirtyConnections.erase(pPlayerComponent->ConnectionId);
+
+    m_wakeup.notify_one();
+}
+
+void PersistenceService::OnPlayerEnterWorld(const PlayerEnterWorldEvent& acEvent) noexcept
+{
+    const auto itor = m_awaitingCharacter.find(acEvent.Entity);
+    if (itor == std::end(m_awaitingCharacter))
+        return;
+
+    Restore(acEvent.Entity, itor->second);
+
+    m_awaitingCharacter.erase(itor);
+}
+
+template<class T>
+void PersistenceService::OnStateChange(const PacketEvent<T>& acMessage) noexcept
+{
+    if (IsEnabled())
+        m_dirtyConnections.insert(acMessage.ConnectionId);
+}
+
+std::string PersistenceService::GetKey(const PlayerComponent& acPlayerComponent) noexcept
+{
+    const auto cKey = acPlayerComponent.GetPersistentKey();
+
+    return std::string(cKey.c_str(), cKey.size());
+}
+
+void PersistenceService::Enqueue(entt::entity aPlayer) noexcept
+{
+    const auto* pPlayerComponent = m_world.try_get<PlayerComponent>(aPlayer);
+    if (!pPlayerComponent)
+        return;
+
+    // Until the stored record is applied the components don't hold it, writing them would replace it with empty state
+    if (m_loadedPlayers.count(aPlayer) == 0)
+        return;
+
+    // Can be called from within the small stack allocator used on disconnection, encode in our own scratch space
+    static thread_local ScratchAllocator s_allocator{ 1 << 18 };
+    ScopedAllocator _{ s_allocator };
+
+    struct ScopedReset
+    {
+        ~ScopedReset() { s_allocator.Reset(); }
+    } allocatorGuard;
+
+    Record record;
+    record.Key = GetKey(*pPlayerComponent);
+
+    if (const auto* pQuestLogComponent = m_world.try_get<QuestLogComponent>(aPlayer))
+        record.Quests = Encode(pQuestLogComponent->QuestContent);
+
+    if (pPlayerComponent->Character && m_world.valid(*pPlayerComponent->Character))
+    {
+        const auto cCharacter = *pPlayerComponent->Character;
+
+        if (const auto* pInventoryComponent = m_world.try_get<InventoryComponent>(cCharacter))
+            record.Inventory = Encode(pInventoryComponent->Content);
+
+        if (const auto* pActorValuesComponent = m_world.try_get<ActorValuesComponent>(cCharacter))
+            record.ActorValues = Encode(pActorValuesComponent->CurrentActorValues);
+
+        if (const auto* pCharacterComponent = m_world.try_get<CharacterComponent>(cCharacter))
+            record.Character = EncodeCharacter(*pCharacterComponent);
+    }
+
+    std::scoped_lock lock(m_lock);
+    m_pendingWrites.push_back(std::move(record));
+}
+
+void PersistenceService::Flush() noexcept
+{
+    if (m_dirtyConnections.empty())
+        return;
+
+    auto view = m_world.view<PlayerComponent>();
+    for (auto entity : view)
+    {
+        const auto cConnectionId = view.get<PlayerComponent>(entity).ConnectionId;
+
+        // Players still waiting on their record stay dirty, they are written once it has been applied
+        if (m_loadedPlayers.count(entity) && m_dirtyConnections.erase(cConnectionId))
+            Enqueue(entity);
+    }
+
+    m_wakeup.notify_one();
+}
+
+void PersistenceService::Restore(entt::entity aPlayer, const Record& acRecord) noexcept
+{
+    const auto& playerComponent = m_world.get<PlayerComponent>(aPlayer);
+
+    // The owning client is authoritative for what it already sent us, the store only fills what it lost
+    if (auto* pQuestLogComponent = m_world.try_get<QuestLogComponent>(aPlayer))
+    {
+        QuestLog storedQuests;
+        Decode(acRecord.Quests, storedQuests);
+
+        auto& questLog = pQuestLogComponent->QuestContent;
+        for (const auto& storedEntry : storedQuests.GetEntries())
+        {
+            if (questLog.Find(storedEntry.Id))
+                continue;
+
+            questLog.Set(storedEntry.Id, storedEntry.Stage);
+            m_world.GetQuestService().StartStopQuest(aPlayer, storedEntry.Id, false);
+        }
+    }
+
+    const auto cCharacter = *playerComponent.Character;
+
+    if (auto* pInventoryComponent = m_world.try_get<InventoryComponent>(cCharacter); pInventoryComponent && pInventoryComponent->Content.Buffer.empty())
+    {
+        Decode(acRecord.Inventory, pInventoryComponent->Content);
+        pInventoryComponent->Version++;
+        m_world.GetCharacterService().MarkInventoryDirty(cCharacter);
+    }
+
+    if (auto* pActorValuesComponent = m_world.try_get<ActorValuesComponent>(cCharacter); pActorValuesComponent && pActorValuesComponent->CurrentActorValues.ActorValuesList.empty())
+    {
+        Decode(acRecord.ActorValues, pActorValuesComponent->CurrentActorValues);
+        pActorValuesComponent->Version++;
+    }
+
+    if (auto* pCharacterComponent = m_world.try_get<CharacterComponent>(cCharacter); pCharacterComponent && pCharacterComponent->SaveBuffer.empty())
+    {
+        DecodeCharacter(acRecord.Character, *pCharacterComponent);
+        pCharacterComponent->Version++;
+        m_world.GetCharacterService().MarkFactionsDirty(cCharacter);
+    }
+
+    m_loadedPlayers.insert(aPlayer);
+    m_dirtyConnections.insert(playerComponent.ConnectionId);
+
+    spdlog::info("Restored persisted state of {}", acRecord.Key);
+}
+
+void PersistenceService::LoadMods() noexcept
+{
+    auto& mods = m_world.ctx<ModsComponent>();
+
+    sqlite3_stmt* pStatement = nullptr;
+    if (sqlite3_prepare_v2(m_pDatabase, "SELECT filename, lite, id FROM mods", -1, &pStatement, nullptr) != SQLITE_OK)
+        return;
+
+    while (sqlite3_step(pStatement) == SQLITE_ROW)
+    {
+        const String filename = reinterpret_cast<const char*>(sqlite3_column_text(pStatement, 0));
+        const auto cLite = sqlite3_column_int(pStatement, 1) != 0;
+        const auto cId = static_cast<uint32_t>(sqlite3_column_int64(pStatement, 2));
+
+        mods.Restore(filename, cId, cLite);
+    }
+
+    sqlite3_finalize(pStatement);
+}
+
+void PersistenceService::Run() noexcept
+{
+    std::unique_lock lock(m_lock);
+
+    while (true)
+    {
+        m_wakeup.wait(lock, [this]()
+        {
+            return !m_running || !m_pendingWrites.empty() || !m_pendingMods.empty() || !m_pendingLoads.empty();
+        });
+
+        const auto cStop = !m_running;
+
+        auto writes = std::move(m_pendingWrites);
+        auto mods = std::move(m_pendingMods);
+        auto loads = std::move(m_pendingLoads);
+        m_pendingWrites.clear();
+        m_pendingMods.clear();
+        m_pendingLoads.clear();
+
+        lock.unlock();
+
+        // Writes go first so a player reconnecting right after leaving reads what they left with
+        Write(writes, mods);
+
+        for (auto& load : loads)
+            Read(load);
+
+        lock.lock();
+
+        m_completedLoads.insert(std::end(m_completedLoads), std::make_move_iterator(std::begin(loads)), std::make_move_iterator(std::end(loads)));
+
+        if (cStop)
+            break;
+    }
+}
+
+void PersistenceService::Write(const std::vector<Record>& acRecords, const std::vector<ModRecord>& acMods) noexcept
+{
+    if (acRecords.empty() && acMods.empty())
+        return;
+
+    sqlite3_exec(m_pDatabase, "BEGIN TRANSACTION", nullptr, nullptr, nullptr);
+
+    sqlite3_stmt* pStatement = nullptr;
+    if (sqlite3_prepare_v2(m_pDatabase,
+        "INSERT OR REPLACE INTO players (key, quests, inventory, actor_values, character, updated) VALUES (?, ?, ?, ?, ?, strftime('%s', 'now'))",
+        -1, &pStatement, nullptr) == SQLITE_OK)
+    {
+        for (const auto& record : acRecords)
+        {
+            sqlite3_bind_text(pStatement, 1, record.Key.c_str(), static_cast<int>(record.Key.size()), SQLITE_STATIC);
+            sqlite3_bind_blob(pStatement, 2, record.Quests.data(), static_cast<int>(record.Quests.size()), SQLITE_STATIC);
+            sqlite3_bind_blob(pStatement, 3, record.Inventory.data(), static_cast<int>(record.Inventory.size()), SQLITE_STATIC);
+            sqlite3_bind_blob(pStatement, 4, record.ActorValues.data(), static_cast<int>(record.ActorValues.size()), SQLITE_STATIC);
+            sqlite3_bind_blob(pStatement, 5, record.Character.data(), static_cast<int>(record.Character.size()), SQLITE_STATIC);
+
+            if (sqlite3_step(pStatement) != SQLITE_DONE)
+                spdlog::error("Unable to persist {}: {}", record.Key, sqlite3_errmsg(m_pDatabase));
+
+            sqlite3_reset(pStatement);
+        }
+
+        sqlite3_finalize(pStatement);
+    }
+
+    if (sqlite3_prepare_v2(m_pDatabase, "INSERT OR IGNORE INTO mods (filename, lite, id) VALUES (?, ?, ?)", -1, &pStatement, nullptr) == SQLITE_OK)
+    {
+        for (const auto& mod : acMods)
+        {
+            sqlite3_bind_text(pStatement, 1, mod.Filename.c_str(), static_cast<int>(mod.Filename.size()), SQLITE_STATIC);
+            sqlite3_bind_int(pStatement, 2, mod.Lite ? 1 : 0);
+            sqlite3_bind_int64(pStatement, 3, mod.Id);
+
+            sqlite3_step(pStatement);
+            sqlite3_reset(pStatement);
+        }
+
+        sqlite3_finalize(pStatement);
+    }
+
+    sqlite3_exec(m_pDatabase, "COMMIT", nullptr, nullptr, nullptr);
+}
+
+void PersistenceService::Read(Load& aLoad) noexcept
+{
+    sqlite3_stmt* pStatement = nullptr;
+    if (sqlite3_prepare_v2(m_pDatabase, "SELECT quests, inventory, actor_values, character FROM players WHERE key = ?", -1, &pStatement, nullptr) != SQLITE_OK)
+        return;
+
+    sqlite3_bind_text(pStatement, 1, aLoad.Key.c_str(), static_cast<int>(aLoad.Key.size()), SQLITE_STATIC);
+
+    if (sqlite3_step(pStatement) == SQLITE_ROW)
+    {
+        Record record;
+        record.Key = aLoad.Key;
+        record.Quests = ReadBlob(pStatement, 0);
+        record.Inventory = ReadBlob(pStatement, 1);
+        record.ActorValues = ReadBlob(pStatement, 2);
+        record.Character = ReadBlob(pStatement, 3);
+
+        aLoad.Result = std::move(record);
+    }
+
+    sqlite3_finalize(pStatement);
+}
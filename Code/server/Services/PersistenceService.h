@@ -0,0 +1,105 @@
+#pragma once
+
+#include <Events/PacketEvent.h>
+
+#include <thread>
+#include <condition_variable>
+
+struct World;
+struct UpdateEvent;
+struct PlayerJoinEvent;
+struct PlayerLeaveEvent;
+struct PlayerEnterWorldEvent;
+struct PlayerComponent;
+struct sqlite3;
+
+struct PersistenceService
+{
+    PersistenceService(World& aWorld, entt::dispatcher& aDispatcher) noexcept;
+    ~PersistenceService() noexcept;
+
+    TP_NOCOPYMOVE(PersistenceService);
+
+    // Opens the store and starts the writer thread, persistence stays disabled if this is never called.
+    // Parties are not part of the store, they only survive a restart through the world snapshot
+    bool Initialize(const String& acPath) noexcept;
+
+    [[nodiscard]] bool IsEnabled() const noexcept { return m_pDatabase != nullptr; }
+
+protected:
+
+    void OnUpdate(const UpdateEvent& acEvent) noexcept;
+    void OnPlayerJoin(const PlayerJoinEvent& acEvent) noexcept;
+    void OnPlayerLeave(const PlayerLeaveEvent& acEvent) noexcept;
+    void OnPlayerEnterWorld(const PlayerEnterWorldEvent& acEvent) noexcept;
+
+    template<class T>
+    void OnStateChange(const PacketEvent<T>& acMessage) noexcept;
+
+private:
+
+    // Records cross threads, they use std containers so they never hold memory from a scoped allocator
+    struct Record
+    {
+        std::string Key;
+        std::string Quests;
+        std::string Inventory;
+        std::string ActorValues;
+        std::string Character;
+    };
+
+    struct ModRecord
+    {
+        std::string Filename;
+        uint32_t Id;
+        bool Lite;
+    };
+
+    struct Load
+    {
+        entt::entity Player;
+        std::string Key;
+        std::optional<Record> Result;
+    };
+
+    [[nodiscard]] static std::string GetKey(const PlayerComponent& acPlayerComponent) noexcept;
+
+    void Enqueue(entt::entity aPlayer) noexcept;
+    void Flush() noexcept;
+    void Restore(entt::entity aPlayer, const Record& acRecord) noexcept;
+    void LoadMods() noexcept;
+
+    // Worker thread
+    void Run() noexcept;
+    void Write(const std::vector<Record>& acRecords, const std::vector<ModRecord>& acMods) noexcept;
+    void Read(Load& aLoad) noexcept;
+
+    World& m_world;
+
+    sqlite3* m_pDatabase{ nullptr };
+    std::thread m_thread;
+    std::mutex m_lock;
+    std::condition_variable m_wakeup;
+    bool m_running{ false };
+
+    // Guarded by m_lock
+    std::vector<Record> m_pendingWrites;
+    std::vector<ModRecord> m_pendingMods;
+    std::vector<Load> m_pendingLoads;
+    std::vector<Load> m_completedLoads;
+
+    Set<ConnectionId_t> m_dirtyConnections;
+    Map<entt::entity, Record> m_awaitingCharacter;
+    // Players whose stored record was applied or who had none, only those are written back
+    Set<entt::entity> m_loadedPlayers;
+
+    entt::scoped_connection m_updateConnection;
+    entt::scoped_connection m_playerJoinConnection;
+    entt::scoped_connection m_playerLeaveConnection;
+    entt::scoped_connection m_playerEnterWorldConnection;
+    entt::scoped_connection m_inventoryChangesConnection;
+    entt::scoped_connection m_factionsChangesConnection;
+    entt::scoped_connection m_questUpdateConnection;
+    entt::scoped_connection m_actorValueChangesConnection;
+    entt::scoped_connection m_actorMaxValueChangesConnection;
+};
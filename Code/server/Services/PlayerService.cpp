@@ -7,16 +7,46 @@
 #include <Components.h>
 #include <GameServer.h>
 
+#include <Events/UpdateEvent.h>
+#include <Events/PlayerLeaveEvent.h>
+
 #include <Messages/EnterCellRequest.h>
-#include <Messages/CharacterSpawnRequest.h>
+#include <Messages/NotifyCharacterSpawnBatch.h>
+
+namespace
+{
+// Keeps a batch well under the 64KB send buffer even with large inventories
+constexpr size_t cSpawnsPerBatch = 8;
+}
 
 PlayerService::PlayerService(World& aWorld, entt::dispatcher& aDispatcher) noexcept
     : m_world(aWorld)
+    , m_updateConnection(aDispatcher.sink<UpdateEvent>().connect<&PlayerService::OnUpdate>(this))
+    , m_playerLeaveConnection(aDispatcher.sink<PlayerLeaveEvent>().connect<&PlayerService::OnPlayerLeave>(this))
     , m_cellEnterConnection(aDispatcher.sink<PacketEvent<EnterCellRequest>>().connect<&PlayerService::HandleCellEnter>(this))
 {
 }
 
-void PlayerService::HandleCellEnter(const PacketEvent<EnterCellRequest>& acMessage) const noexcept
+void PlayerService::OnUpdate(const UpdateEvent& acEvent) noexcept
+{
+    // One batch per connection per tick spreads large cells over several frames
+    for (auto itor = std::begin(m_pendingSpawns); itor != std::end(m_pendingSpawns);)
+    {
+        if (!SendSpawnBatch(itor->first, itor.value()))
+            itor = m_pendingSpawns.erase(itor);
+        else
+            ++itor;
+    }
+}
+
+void PlayerService::OnPlayerLeave(const PlayerLeaveEvent& acEvent) noexcept
+{
+    const auto& playerComponent = m_world.get<PlayerComponent>(acEvent.Entity);
+
+    m_pendingSpawns.erase(playerComponent.ConnectionId);
+}
+
+void PlayerService::HandleCellEnter(const PacketEvent<EnterCellRequest>& acMessage) noexcept
 {
     auto playerView = m_world.view<PlayerComponent>();
 
@@ -51,6 +81,12 @@ void PlayerService::HandleCellEnter(const PacketEvent<EnterCellRequest>& acMessa
             m_world.emplace<CellIdComponent>(*playerComponent.Character, message.CellId);
     }
 
+    const MovementComponent* pPlayerMovement = nullptr;
+    if (playerComponent.Character)
+        pPlayerMovement = m_world.try_get<MovementComponent>(*playerComponent.Character);
+
+    Vector<std::pair<float, entt::entity>> candidates;
+
     auto characterView = m_world.view<CellIdComponent, CharacterComponent, OwnerComponent>();
     for (auto character : characterView)
     {
@@ -63,9 +99,67 @@ void PlayerService::HandleCellEnter(const PacketEvent<EnterCellRequest>& acMessa
         if (message.CellId != characterView.get<CellIdComponent>(character).Cell)
             continue;
 
-        CharacterSpawnRequest spawnMessage;
-        CharacterService::Serialize(m_world, character, &spawnMessage);
+        float distance = 0.f;
 
-        GameServer::Get()->Send(acMessage.ConnectionId, spawnMessage);
+        const auto* pMovementComponent = m_world.try_get<MovementComponent>(character);
+        if (pPlayerMovement && pMovementComponent)
+        {
+            const auto cDelta = pMovementComponent->Position - pPlayerMovement->Position;
+            distance = glm::dot(cDelta, cDelta);
+        }
+
+        candidates.emplace_back(distance, character);
     }
+
+    // A new cell replaces whatever was still pending for the previous one
+    if (candidates.empty())
+    {
+        m_pendingSpawns.erase(acMessage.ConnectionId);
+        return;
+    }
+
+    std::sort(std::begin(candidates), std::end(candidates), [](const auto& acLhs, const auto& acRhs) {
+        return acLhs.first > acRhs.first;
+    });
+
+    auto& pendingSpawns = m_pendingSpawns[acMessage.ConnectionId];
+    pendingSpawns.Cell = message.CellId;
+    pendingSpawns.Characters.clear();
+    pendingSpawns.Characters.reserve(candidates.size());
+
+    for (const auto& [distance, character] : candidates)
+        pendingSpawns.Characters.push_back(character);
+
+    // The nearest characters go out right away, the rest follows on the next ticks
+    if (!SendSpawnBatch(acMessage.ConnectionId, pendingSpawns))
+        m_pendingSpawns.erase(acMessage.ConnectionId);
+}
+
+bool PlayerService::SendSpawnBatch(ConnectionId_t aConnectionId, PendingSpawns& aPendingSpawns) const noexcept
+{
+    NotifyCharacterSpawnBatch message;
+
+    auto& characters = aPendingSpawns.Characters;
+
+    while (!characters.empty() && message.Spawns.size() < cSpawnsPerBatch)
+    {
+        const auto character = characters.back();
+        characters.pop_back();
+
+        // The character may have been removed while it was queued
+        if (!m_world.valid(character) || !m_world.has<CharacterComponent>(character))
+            continue;
+
+        // Or left the cell, the client would spawn it where it no longer is
+        const auto* pCellIdComponent = m_world.try_get<CellIdComponent>(character);
+        if (!pCellIdComponent || pCellIdComponent->Cell != aPendingSpawns.Cell)
+            continue;
+
+        CharacterService::Serialize(m_world, character, &message.Spawns.emplace_back());
+    }
+
+    if (!message.Spawns.empty())
+        GameServer::Get()->Send(aConnectionId, message);
+
+    return !characters.empty();
 }
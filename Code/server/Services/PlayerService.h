@@ -1,8 +1,11 @@
 #pragma once
 
 #include <Events/PacketEvent.h>
+#include <Structs/GameId.h>
 
 struct World;
+struct UpdateEvent;
+struct PlayerLeaveEvent;
 struct EnterCellRequest;
 
 struct PlayerService
@@ -14,11 +17,29 @@ struct PlayerService
 
 protected:
 
-    void HandleCellEnter(const PacketEvent<EnterCellRequest>& acMessage) const noexcept;
+    void OnUpdate(const UpdateEvent& acEvent) noexcept;
+    void OnPlayerLeave(const PlayerLeaveEvent& acEvent) noexcept;
+    void HandleCellEnter(const PacketEvent<EnterCellRequest>& acMessage) noexcept;
 
 private:
 
+    struct PendingSpawns
+    {
+        // Cell the player was in when the spawns were queued, characters that left it since are skipped
+        GameId Cell{};
+        // Sorted farthest first so the nearest are popped first
+        Vector<entt::entity> Characters;
+    };
+
+    // Sends the next batch of pending spawns, returns false once nothing is left to send
+    bool SendSpawnBatch(ConnectionId_t aConnectionId, PendingSpawns& aPendingSpawns) const noexcept;
+
     World& m_world;
 
+    // Characters still to be spawned on each connection
+    Map<ConnectionId_t, PendingSpawns> m_pendingSpawns;
+
+    entt::scoped_connection m_updateConnection;
+    entt::scoped_connection m_playerLeaveConnection;
     entt::scoped_connection m_cellEnterConnection;
 };
@@ -6,6 +6,9 @@
 
 #include <World.h>
 #include <Services/QuestService.h>
+#include <Services/PartyService.h>
+
+#include <Events/UpdateEvent.h>
 
 #include <Messages/RequestQuestUpdate.h>
 #include <Messages/NotifyQuestUpdate.h>
@@ -17,6 +20,30 @@ QuestService::QuestService(World& aWorld, entt::dispatcher& aDispatcher) : m_wor
 {
     m_questUpdateConnection =
         aDispatcher.sink<PacketEvent<RequestQuestUpdate>>().connect<&QuestService::HandleQuestChanges>(this);
+    m_updateConnection = aDispatcher.sink<UpdateEvent>().connect<&QuestService::OnUpdate>(this);
+}
+
+void QuestService::OnUpdate(const UpdateEvent& acEvent) noexcept
+{
+    if (m_pendingUpdates.empty())
+        return;
+
+    for (auto& [recipient, batch] : m_pendingUpdates)
+    {
+        // Left since the update was queued
+        if (!m_world.valid(recipient))
+            continue;
+
+        if (const auto* pPlayerComponent = m_world.try_get<PlayerComponent>(recipient))
+            GameServer::Get()->Send(pPlayerComponent->ConnectionId, batch);
+    }
+
+    m_pendingUpdates.clear();
+}
+
+void QuestService::QueueUpdate(entt::entity aRecipient, const NotifyQuestUpdate& acUpdate) noexcept
+{
+    m_pendingUpdates[aRecipient].Updates.push_back(acUpdate);
 }
 
 void QuestService::HandleQuestChanges(const PacketEvent<RequestQuestUpdate>& acMessage) noexcept
@@ -37,13 +64,11 @@ void QuestService::HandleQuestChanges(const PacketEvent<RequestQuestUpdate>& acM
         return;
     }
 
-    auto& questComponent = view.get<QuestLogComponent>(*it);
-    auto& entries = questComponent.QuestContent.Entries;
+    auto& questLog = view.get<QuestLogComponent>(*it).QuestContent;
 
-    auto questIt = std::find_if(entries.begin(), entries.end(), [&message](const auto& e) 
-    { 
-        return e.Id == message.Id;
-    });
+    NotifyQuestUpdate update;
+    update.Id = message.Id;
+    update.Stage = message.Stage;
 
     if (message.Status == RequestQuestUpdate::Started || 
         message.Status == RequestQuestUpdate::StageUpdate)
@@ -51,12 +76,11 @@ void QuestService::HandleQuestChanges(const PacketEvent<RequestQuestUpdate>& acM
         // in order to prevent bugs when a quest is in progress
         // and being updated we add it as a new quest record to
         // maintain a proper remote questlog state.
-        if (questIt == entries.end())
-        {
-            auto& newQuest = entries.emplace_back();
-            newQuest.Id = message.Id;
-            newQuest.Stage = message.Stage;
+        const bool cAdded = questLog.Find(message.Id) == nullptr;
+        const bool cChanged = questLog.Set(message.Id, message.Stage);
 
+        if (cAdded)
+        {
             if (message.Status == RequestQuestUpdate::Started)
             {
                 spdlog::info("Started Quest: {:x}:{}", message.Id.BaseId, message.Id.ModId);
@@ -72,15 +96,18 @@ void QuestService::HandleQuestChanges(const PacketEvent<RequestQuestUpdate>& acM
         {
             spdlog::info("Updated quest: {:x}:{}", message.Id.BaseId, message.Stage);
 
-            auto& record = *questIt;
-            record.Id = message.Id;
-            record.Stage = message.Stage;
-
             const Script::Player scriptPlayer(*it, m_world);
             const Script::Quest scriptQuest(message.Id.BaseId, message.Stage, m_world);
 
             m_world.GetScriptService().HandleQuestStage(scriptPlayer, scriptQuest);
         }
+
+        // Members echo what we sent them, those echoes don't change anything and stop here
+        if (cChanged)
+        {
+            update.Status = cAdded ? NotifyQuestUpdate::Started : NotifyQuestUpdate::StageUpdate;
+            ShareWithParty(*it, update);
+        }
     }
     else if (message.Status == RequestQuestUpdate::Stopped)
     {
@@ -89,9 +116,10 @@ void QuestService::HandleQuestChanges(const PacketEvent<RequestQuestUpdate>& acM
         const Script::Player player(*it, m_world);
         m_world.GetScriptService().HandleQuestStop(player, message.Id.BaseId);
 
-        if (questIt != entries.end())
+        if (questLog.Remove(message.Id))
         {
-            entries.erase(questIt);
+            update.Status = NotifyQuestUpdate::Stopped;
+            ShareWithParty(*it, update);
         }
         else
         {
@@ -99,6 +127,35 @@ void QuestService::HandleQuestChanges(const PacketEvent<RequestQuestUpdate>& acM
         }
     }
 }
+
+void QuestService::ShareWithParty(entt::entity aSource, const NotifyQuestUpdate& acUpdate) noexcept
+{
+    const auto* pPartyComponent = m_world.try_get<PartyComponent>(aSource);
+    if (!pPartyComponent || !pPartyComponent->JoinedPartyId)
+        return;
+
+    const auto* pParty = m_world.ctx<PartyService>().GetById(*pPartyComponent->JoinedPartyId);
+    if (!pParty)
+        return;
+
+    for (auto member : pParty->Members)
+    {
+        if (member == aSource)
+            continue;
+
+        auto* pQuestLogComponent = m_world.try_get<QuestLogComponent>(member);
+        if (!pQuestLogComponent)
+            continue;
+
+        auto& questLog = pQuestLogComponent->QuestContent;
+
+        const bool cChanged = acUpdate.Status == NotifyQuestUpdate::Stopped ? 
+            questLog.Remove(acUpdate.Id) : questLog.Set(acUpdate.Id, acUpdate.Stage);
+
+        if (cChanged)
+            QueueUpdate(member, acUpdate);
+    }
+}
   
 // script wrapper
 bool QuestService::StartStopQuest(entt::entity aRecipient, GameId aGameId, bool aStop) noexcept
@@ -108,8 +165,7 @@ bool QuestService::StartStopQuest(entt::entity aRecipient, GameId aGameId, bool
     questMsg.Id = aGameId;
     questMsg.Stage = 0;
 
-    auto& playerComponent = m_world.get<PlayerComponent>(aRecipient);
-    GameServer::Get()->Send(playerComponent.ConnectionId, questMsg);
+    QueueUpdate(aRecipient, questMsg);
 
     return true;
 }
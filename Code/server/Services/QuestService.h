@@ -2,6 +2,7 @@
 
 #include <Events/PacketEvent.h>
 #include <Structs/GameId.h>
+#include <Messages/NotifyQuestUpdateBatch.h>
 
 struct World;
 struct UpdateEvent;
@@ -13,8 +14,16 @@ public:
     QuestService(World& aWorld, entt::dispatcher& aDispatcher);
 
     bool StartStopQuest(entt::entity aRecipient, GameId aGameId, bool aStop) noexcept;
+    // Everything queued for a player during a tick goes out as a single message
+    void QueueUpdate(entt::entity aRecipient, const NotifyQuestUpdate& acUpdate) noexcept;
+
 private:
+    void OnUpdate(const UpdateEvent& acEvent) noexcept;
     void HandleQuestChanges(const PacketEvent<RequestQuestUpdate>& aChanges) noexcept;
+    // Applies a change made by aSource to the logs of its party members, only the ones it actually changes hear about it
+    void ShareWithParty(entt::entity aSource, const NotifyQuestUpdate& acUpdate) noexcept;
+
+    Map<entt::entity, NotifyQuestUpdateBatch> m_pendingUpdates;
 
     entt::scoped_connection m_questUpdateConnection;
     entt::scoped_connection m_updateConnection;
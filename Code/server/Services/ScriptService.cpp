@@ -28,6 +28,13 @@ ScriptService::ScriptService(World& aWorld, entt::dispatcher& aDispatcher)
 {
 }
 
+ScriptService::~ScriptService() noexcept
+{
+    // The timer service outlives us and must not keep functions of a dead script state around
+    ClearScriptTimers();
+    m_world.GetTimerService().Cancel(m_scriptsCheckTimer);
+}
+
 Vector<Script::Player> ScriptService::GetPlayers() const
 {
     Vector<Script::Player> players;
@@ -54,10 +61,48 @@ Vector<Script::Npc> ScriptService::GetNpcs() const
     return npcs;
 }
 
-void ScriptService::Initialize() noexcept
+void ScriptService::Initialize(bool aHotReload) noexcept
 {
-    auto path = TiltedPhoques::GetPath() / "scripts"; 
-    LoadFullScripts(path);
+    m_scriptsPath = TiltedPhoques::GetPath() / "scripts";
+    m_hotReload = aHotReload;
+
+    LoadFullScripts(m_scriptsPath);
+
+    if (m_hotReload)
+    {
+        m_scriptsSignature = GetScriptsSignature();
+        spdlog::info("Watching {} for script changes", m_scriptsPath.string());
+
+        // Hitting the disk every tick is pointless, a second is responsive enough when editing
+        m_scriptsCheckTimer = m_world.GetTimerService().SetInterval(1s, [this]() { CheckForScriptChanges(); });
+    }
+}
+
+void ScriptService::Reload() noexcept
+{
+    // Keep the replicated objects around, scripts only get their definitions and handlers replaced
+    const auto objects = GenerateFull();
+
+    m_callbacks.clear();
+    ClearScriptTimers();
+
+    Reset();
+    LoadFullScripts(m_scriptsPath);
+
+    Buffer buff(objects.Data.data(), objects.Data.size());
+    Buffer::Reader reader(&buff);
+
+    GetNetState()->LoadFullSnapshot(reader);
+
+    // Loaded clients swap their definitions in place instead of reconnecting
+    ServerScriptUpdate message;
+    message.Reload = true;
+    message.Definitions = SerializeScripts();
+    message.ReplicatedObjects = GenerateFull();
+
+    GameServer::Get()->SendToLoaded(message);
+
+    spdlog::info("Scripts reloaded");
 }
 
 Scripts ScriptService::SerializeScripts() noexcept
@@ -210,6 +255,9 @@ void ScriptService::BindTypes(ScriptContext& aContext) noexcept
     npcType["position"] = sol::readonly_property(&Npc::GetPosition);
     npcType["rotation"] = sol::readonly_property(&Npc::GetRotation);
     npcType["speed"] = sol::readonly_property(&Npc::GetSpeed);
+    npcType["health"] = sol::readonly_property(&Npc::GetHealth);
+    npcType["GetPositionAt"] = &Npc::GetPositionAt;
+    npcType["GetRotationAt"] = &Npc::GetRotationAt;
     npcType["AddComponent"] = &Npc::AddComponent;
 
     auto playerType = aContext.new_usertype<Player>("Player", sol::no_constructor);
@@ -256,6 +304,18 @@ void ScriptService::BindStaticFunctions(ScriptContext& aContext) noexcept
     { 
         CancelEvent(std::move(acReason)); 
     });
+    aContext.set_function("setTimeout", [this](sol::function aFunction, uint32_t aMilliseconds)
+    {
+        return AddScriptTimer(std::move(aFunction), aMilliseconds, false);
+    });
+    aContext.set_function("setInterval", [this](sol::function aFunction, uint32_t aMilliseconds)
+    {
+        return AddScriptTimer(std::move(aFunction), aMilliseconds, true);
+    });
+    aContext.set_function("clearTimer", [this](uint32_t aId)
+    {
+        ClearScriptTimer(aId);
+    });
 }
 
 void ScriptService::AddEventHandler(const std::string acName, const sol::function acFunction) noexcept
@@ -268,3 +328,80 @@ void ScriptService::CancelEvent(const std::string aReason) noexcept
     m_eventCanceled = true;
     m_cancelReason = aReason;
 }
+
+uint32_t ScriptService::AddScriptTimer(sol::function aFunction, uint32_t aMilliseconds, bool aRepeat) noexcept
+{
+    const auto cId = m_nextScriptTimerId++;
+
+    auto callback = [this, cId, aRepeat, function = std::move(aFunction)]()
+    {
+        // Forget one shot timers first so the function can't clear an id that is already gone
+        if (!aRepeat)
+            m_scriptTimers.erase(cId);
+
+        auto result = function();
+        if (!result.valid())
+        {
+            sol::error err = result;
+            spdlog::error(err.what());
+        }
+    };
+
+    auto& timerService = m_world.GetTimerService();
+    const std::chrono::milliseconds cDelay{ aMilliseconds };
+
+    m_scriptTimers[cId] = aRepeat ? timerService.SetInterval(cDelay, std::move(callback)) : timerService.SetTimeout(cDelay, std::move(callback));
+
+    return cId;
+}
+
+void ScriptService::ClearScriptTimer(uint32_t aId) noexcept
+{
+    auto itor = m_scriptTimers.find(aId);
+    if (itor == std::end(m_scriptTimers))
+        return;
+
+    m_world.GetTimerService().Cancel(itor->second);
+    m_scriptTimers.erase(itor);
+}
+
+void ScriptService::ClearScriptTimers() noexcept
+{
+    auto& timerService = m_world.GetTimerService();
+
+    for (auto& timer : m_scriptTimers)
+        timerService.Cancel(timer.second);
+
+    m_scriptTimers.clear();
+}
+
+void ScriptService::CheckForScriptChanges() noexcept
+{
+    const auto cSignature = GetScriptsSignature();
+    if (cSignature == m_scriptsSignature)
+        return;
+
+    m_scriptsSignature = cSignature;
+
+    Reload();
+}
+
+std::pair<std::filesystem::file_time_type, size_t> ScriptService::GetScriptsSignature() const noexcept
+{
+    std::error_code ec;
+    std::filesystem::file_time_type latest{};
+    size_t count = 0;
+
+    // The newest write time catches edits and additions, the file count catches deletions
+    for (auto itor = std::filesystem::recursive_directory_iterator(m_scriptsPath, ec);
+         !ec && itor != std::filesystem::recursive_directory_iterator(); itor.increment(ec))
+    {
+        if (!itor->is_regular_file(ec) || itor->path().extension() != ".lua")
+            continue;
+
+        latest = std::max(latest, itor->last_write_time(ec));
+        ++count;
+    }
+
+    return {latest, count};
+}
@@ -3,6 +3,7 @@
 #include <Events/UpdateEvent.h>
 #include <ScriptStore.h>
 #include <Events/PacketEvent.h>
+#include <Services/TimerService.h>
 
 #include <Structs/Objects.h>
 #include <Structs/FullObjects.h>
@@ -22,11 +23,12 @@ namespace Script
 struct ScriptService : ScriptStore
 {
     ScriptService(World& aWorld, entt::dispatcher& aDispatcher);
-    ~ScriptService() noexcept = default;
+    ~ScriptService() noexcept;
 
     TP_NOCOPYMOVE(ScriptService);
 
-    void Initialize() noexcept;
+    void Initialize(bool aHotReload) noexcept;
+    void Reload() noexcept;
     Scripts SerializeScripts() noexcept;
     Objects GenerateDifferential() noexcept;
     FullObjects GenerateFull() noexcept;
@@ -54,6 +56,14 @@ protected:
     void AddEventHandler(std::string acName, sol::function acFunction) noexcept;
     void CancelEvent(std::string aReason) noexcept;
 
+    // Timers handed to scripts, ids are per script state and cleared on reload since their functions die with it
+    uint32_t AddScriptTimer(sol::function aFunction, uint32_t aMilliseconds, bool aRepeat) noexcept;
+    void ClearScriptTimer(uint32_t aId) noexcept;
+    void ClearScriptTimers() noexcept;
+
+    void CheckForScriptChanges() noexcept;
+    [[nodiscard]] std::pair<std::filesystem::file_time_type, size_t> GetScriptsSignature() const noexcept;
+
     [[nodiscard]] Vector<Script::Player> GetPlayers() const;
     [[nodiscard]] Vector<Script::Npc> GetNpcs() const;
 
@@ -73,6 +83,14 @@ private:
     String m_cancelReason;
     Map<String, TCallbacks> m_callbacks;
 
+    std::filesystem::path m_scriptsPath;
+    bool m_hotReload{ false };
+    std::pair<std::filesystem::file_time_type, size_t> m_scriptsSignature{};
+    TimerService::TimerId m_scriptsCheckTimer{TimerService::kInvalidTimer};
+
+    Map<uint32_t, TimerService::TimerId> m_scriptTimers;
+    uint32_t m_nextScriptTimerId{1};
+
     entt::scoped_connection m_updateConnection;
     entt::scoped_connection m_rpcCallsRequest;
     entt::scoped_connection m_playerEnterWorldConnection;
@@ -1,10 +1,10 @@
 #include <stdafx.h>
 
 #include <Services/ServerListService.h>
-#include <Events/UpdateEvent.h>
 #include <Events/PlayerJoinEvent.h>
 #include <Events/PlayerLeaveEvent.h>
 #include <GameServer.h>
+#include <World.h>
 
 #include <future>
 
@@ -23,33 +23,32 @@ static const char* s_listEndpoint = "https://fallout-reborn-list.skyrim-together
 #endif
 
 ServerListService::ServerListService(World& aWorld, entt::dispatcher& aDispatcher) noexcept
-    : m_world(aWorld), m_updateConnection(aDispatcher.sink<UpdateEvent>().connect<&ServerListService::OnUpdate>(this)),
-      m_nextAnnounce(std::chrono::seconds(0))
+    : m_world(aWorld)
 {
-}
-
-void ServerListService::OnUpdate(const UpdateEvent& acEvent) noexcept
-{
-    if (m_nextAnnounce < std::chrono::steady_clock::now())
-    {
-        Announce();
-
-        m_nextAnnounce = (std::chrono::steady_clock::now() + std::chrono::minutes(1));
-    }
+    ScheduleAnnounce(0ms);
 }
 
 void ServerListService::OnPlayerJoin(const PlayerJoinEvent& acEvent) noexcept
 {
     Announce();
-
-    m_nextAnnounce = (std::chrono::steady_clock::now() + std::chrono::minutes(1));
+    ScheduleAnnounce(1min);
 }
 
 void ServerListService::OnPlayerLeave(const PlayerLeaveEvent& acEvent) noexcept
 {
     Announce();
+    ScheduleAnnounce(1min);
+}
 
-    m_nextAnnounce = (std::chrono::steady_clock::now() + std::chrono::minutes(1));
+void ServerListService::ScheduleAnnounce(std::chrono::milliseconds aDelay) noexcept
+{
+    auto& timerService = m_world.GetTimerService();
+
+    timerService.Cancel(m_announceTimer);
+    m_announceTimer = timerService.SetTimeout(aDelay, [this]() {
+        Announce();
+        ScheduleAnnounce(1min);
+    });
 }
 
 void ServerListService::Announce() const noexcept
@@ -1,7 +1,8 @@
 #pragma once
 
+#include <Services/TimerService.h>
+
 struct World;
-struct UpdateEvent;
 struct PlayerJoinEvent;
 struct PlayerLeaveEvent;
 
@@ -14,20 +15,20 @@ struct ServerListService
 
 protected:
 
-    void OnUpdate(const UpdateEvent& acEvent) noexcept;
     void OnPlayerJoin(const PlayerJoinEvent& acEvent) noexcept;
     void OnPlayerLeave(const PlayerLeaveEvent& acEvent) noexcept;
 
 private:
 
     void Announce() const noexcept;
+    // Replaces the pending announce, announces then keep rescheduling themselves a minute apart
+    void ScheduleAnnounce(std::chrono::milliseconds aDelay) noexcept;
 
     static void DoPost(String acName, uint16_t aPort, uint32_t aPlayerCount) noexcept;
 
     World& m_world;
 
-    entt::scoped_connection m_updateConnection;
     entt::scoped_connection m_playerJoinConnection;
     entt::scoped_connection m_playerLeaveConnection;
-    mutable std::chrono::steady_clock::time_point m_nextAnnounce;
+    TimerService::TimerId m_announceTimer{TimerService::kInvalidTimer};
 };
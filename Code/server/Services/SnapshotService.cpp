@@ -0,0 +1,548 @@
+#include <stdafx.h>
+
+#include <Services/SnapshotService.h>
+#include <Services/EnvironmentService.h>
+#include <Services/PartyService.h>
+#include <Components.h>
+#include <World.h>
+#include <GameServer.h>
+
+#include <Events/UpdateEvent.h>
+
+#include <Messages/NotifyRemoveCharacter.h>
+
+#include <fstream>
+
+namespace
+{
+constexpr uint32_t cSnapshotMagic = 0x53575054; // TPWS
+constexpr uint32_t cSnapshotVersion = 5;
+constexpr auto cSnapshotInterval = 5s;
+// Hard cap on the time and entities a snapshot may take from a single tick
+constexpr auto cSnapshotBudget = 1ms;
+constexpr size_t cSnapshotEntitiesPerTick = 256;
+// Restored entities no client has adopted by then are destroyed, otherwise they would live and be saved forever
+constexpr auto cOrphanTimeout = 300s;
+
+// Per component encoding, only state that still makes sense after a restart is stored
+
+void Save(const FormIdComponent& acComponent, Buffer::Writer& aWriter) noexcept
+{
+    acComponent.Id.Serialize(aWriter);
+}
+
+void Load(FormIdComponent& aComponent, Buffer::Reader& aReader) noexcept
+{
+    aComponent.Id.Deserialize(aReader);
+}
+
+void Save(const OwnerComponent&, Buffer::Writer&) noexcept
+{
+    // Connections don't survive a restart, loaded entities are orphaned until a client adopts them
+}
+
+void Load(OwnerComponent& aComponent, Buffer::Reader&) noexcept
+{
+    aComponent.ConnectionId = 0;
+}
+
+void Save(const CellIdComponent& acComponent, Buffer::Writer& aWriter) noexcept
+{
+    acComponent.Cell.Serialize(aWriter);
+}
+
+void Load(CellIdComponent& aComponent, Buffer::Reader& aReader) noexcept
+{
+    aComponent.Cell.Deserialize(aReader);
+}
+
+void Save(const CharacterComponent& acComponent, Buffer::Writer& aWriter) noexcept
+{
+    Serialization::WriteVarInt(aWriter, acComponent.ChangeFlags);
+    Serialization::WriteString(aWriter, acComponent.SaveBuffer);
+    acComponent.BaseId.Id.Serialize(aWriter);
+    acComponent.FaceTints.Serialize(aWriter);
+    acComponent.FactionsContent.Serialize(aWriter);
+}
+
+void Load(CharacterComponent& aComponent, Buffer::Reader& aReader) noexcept
+{
+    aComponent.ChangeFlags = Serialization::ReadVarInt(aReader) & 0xFFFFFFFF;
+    aComponent.SaveBuffer = Serialization::ReadString(aReader);
+    aComponent.BaseId.Id.Deserialize(aReader);
+    aComponent.FaceTints.Deserialize(aReader);
+    aComponent.FactionsContent.Deserialize(aReader);
+}
+
+void Save(const MovementComponent& acComponent, Buffer::Writer& aWriter) noexcept
+{
+    Serialization::WriteVarInt(aWriter, acComponent.Tick);
+
+    for (auto i = 0; i < 3; ++i)
+        Serialization::WriteFloat(aWriter, acComponent.Position[i]);
+    for (auto i = 0; i < 3; ++i)
+        Serialization::WriteFloat(aWriter, acComponent.Rotation[i]);
+
+    Serialization::WriteFloat(aWriter, acComponent.Direction);
+}
+
+void Load(MovementComponent& aComponent, Buffer::Reader& aReader) noexcept
+{
+    // Ticks of the previous process mean nothing to this one, a stale one would make every move look out of date
+    Serialization::ReadVarInt(aReader);
+    aComponent.Tick = 0;
+
+    for (auto i = 0; i < 3; ++i)
+        aComponent.Position[i] = Serialization::ReadFloat(aReader);
+    for (auto i = 0; i < 3; ++i)
+        aComponent.Rotation[i] = Serialization::ReadFloat(aReader);
+
+    aComponent.Direction = Serialization::ReadFloat(aReader);
+    aComponent.Sent = true;
+}
+
+void Save(const AnimationComponent& acComponent, Buffer::Writer& aWriter) noexcept
+{
+    acComponent.CurrentAction.GenerateDifferential(ActionEvent{}, aWriter);
+    acComponent.Variables.GenerateDiff(AnimationVariables{}, aWriter);
+}
+
+void Load(AnimationComponent& aComponent, Buffer::Reader& aReader) noexcept
+{
+    aComponent.CurrentAction.ApplyDifferential(aReader);
+    aComponent.LastSerializedAction = aComponent.CurrentAction;
+    aComponent.Variables.ApplyDiff(aReader);
+}
+
+void Save(const InventoryComponent& acComponent, Buffer::Writer& aWriter) noexcept
+{
+    acComponent.Content.Serialize(aWriter);
+}
+
+void Load(InventoryComponent& aComponent, Buffer::Reader& aReader) noexcept
+{
+    aComponent.Content.Deserialize(aReader);
+}
+
+void Save(const ActorValuesComponent& acComponent, Buffer::Writer& aWriter) noexcept
+{
+    acComponent.CurrentActorValues.Serialize(aWriter);
+}
+
+void Load(ActorValuesComponent& aComponent, Buffer::Reader& aReader) noexcept
+{
+    aComponent.CurrentActorValues.Deserialize(aReader);
+}
+
+template<class T>
+void WriteRaw(std::vector<uint8_t>& aData, T aValue) noexcept
+{
+    const auto* pData = reinterpret_cast<const uint8_t*>(&aValue);
+    aData.insert(std::end(aData), pData, pData + sizeof(T));
+}
+
+// Components are length prefixed so a section can be skipped without decoding it
+template<class T>
+bool SaveComponent(const World& acWorld, entt::entity aEntity, std::vector<uint8_t>& aData, Buffer& aScratch) noexcept
+{
+    const auto* pComponent = acWorld.try_get<T>(aEntity);
+    if (!pComponent)
+        return false;
+
+    Buffer::Writer writer(&aScratch);
+    Save(*pComponent, writer);
+
+    WriteRaw(aData, static_cast<uint32_t>(writer.Size()));
+    aData.insert(std::end(aData), aScratch.GetData(), aScratch.GetData() + writer.Size());
+
+    return true;
+}
+
+// An entity record is its id, a mask of the components that follow and the components in list order
+template<class... Ts>
+void SaveEntity(const World& acWorld, entt::entity aEntity, std::vector<uint8_t>& aData, Buffer& aScratch) noexcept
+{
+    static_assert(sizeof...(Ts) <= 16, "The component mask is 16 bits wide");
+
+    WriteRaw(aData, to_integral(aEntity));
+
+    const auto cMaskPosition = aData.size();
+    WriteRaw(aData, uint16_t{ 0 });
+
+    uint16_t mask = 0;
+    uint16_t bit = 1;
+    ((mask |= SaveComponent<Ts>(acWorld, aEntity, aData, aScratch) ? bit : uint16_t{ 0 }, bit <<= 1), ...);
+
+    std::memcpy(aData.data() + cMaskPosition, &mask, sizeof(mask));
+}
+
+struct SnapshotReader
+{
+    SnapshotReader(const uint8_t* apData, size_t aSize) noexcept
+        : m_pData(apData)
+        , m_size(aSize)
+    {}
+
+    template<class T>
+    void ReadRaw(T& aValue) noexcept
+    {
+        if (m_failed || m_position + sizeof(T) > m_size)
+        {
+            m_failed = true;
+            aValue = T{};
+            return;
+        }
+
+        std::memcpy(&aValue, m_pData + m_position, sizeof(T));
+        m_position += sizeof(T);
+    }
+
+    // Returns null and fails the reader if fewer than aSize bytes are left
+    const uint8_t* Consume(size_t aSize) noexcept
+    {
+        if (m_failed || aSize > m_size - m_position)
+        {
+            m_failed = true;
+            return nullptr;
+        }
+
+        const auto* pData = m_pData + m_position;
+        m_position += aSize;
+
+        return pData;
+    }
+
+    [[nodiscard]] bool IsValid() const noexcept { return !m_failed; }
+
+private:
+
+    const uint8_t* m_pData;
+    size_t m_size;
+    size_t m_position{ 0 };
+    bool m_failed{ false };
+};
+
+template<class T>
+void LoadComponent(World& aWorld, entt::entity aEntity, uint16_t aMask, uint16_t aBit, SnapshotReader& aReader) noexcept
+{
+    if ((aMask & aBit) == 0)
+        return;
+
+    uint32_t size = 0;
+    aReader.ReadRaw(size);
+
+    const auto* pData = aReader.Consume(size);
+    if (!pData)
+        return;
+
+    Buffer buffer(pData, size);
+    Buffer::Reader reader(&buffer);
+
+    T component{};
+    Load(component, reader);
+
+    aWorld.emplace<T>(aEntity, std::move(component));
+}
+
+template<class... Ts>
+bool LoadEntity(World& aWorld, SnapshotReader& aReader) noexcept
+{
+    std::underlying_type_t<entt::entity> id{};
+    uint16_t mask = 0;
+
+    aReader.ReadRaw(id);
+    aReader.ReadRaw(mask);
+
+    if (!aReader.IsValid())
+        return false;
+
+    // Ids are kept when they are free so logs before and after the restart line up
+    const auto cEntity = aWorld.create(entt::entity{id});
+
+    uint16_t bit = 1;
+    ((LoadComponent<Ts>(aWorld, cEntity, mask, bit, aReader), bit <<= 1), ...);
+
+    return aReader.IsValid();
+}
+
+void WriteFile(std::filesystem::path aPath, std::vector<uint8_t> aData) noexcept
+{
+    auto temporaryPath = aPath;
+    temporaryPath += ".tmp";
+
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(aData.data()), aData.size());
+
+        if (!file)
+        {
+            spdlog::error("Unable to write the world snapshot to {}", temporaryPath.string());
+            return;
+        }
+    }
+
+    // Replace in one step so a crash mid write leaves the previous snapshot intact
+    std::error_code ec;
+    std::filesystem::rename(temporaryPath, aPath, ec);
+
+    if (ec)
+        spdlog::error("Unable to replace the world snapshot {}: {}", aPath.string(), ec.message());
+}
+}
+
+#define SNAPSHOT_COMPONENTS FormIdComponent, OwnerComponent, CellIdComponent, CharacterComponent, \
+    MovementComponent, AnimationComponent, InventoryComponent, ActorValuesComponent
+
+SnapshotService::SnapshotService(World& aWorld, entt::dispatcher& aDispatcher) noexcept
+    : m_world(aWorld)
+    , m_scratch(1 << 16)
+    , m_updateConnection(aDispatcher.sink<UpdateEvent>().connect<&SnapshotService::OnUpdate>(this))
+{
+}
+
+SnapshotService::~SnapshotService() noexcept
+{
+    if (m_pendingWrite.valid())
+        m_pendingWrite.wait();
+}
+
+void SnapshotService::Initialize(const String& acPath, bool aRestore) noexcept
+{
+    m_path = acPath.c_str();
+
+    if (aRestore)
+        Restore();
+
+    m_world.GetTimerService().SetInterval(cSnapshotInterval, [this]() { Save(); });
+}
+
+bool SnapshotService::Save() noexcept
+{
+    if (m_saving)
+        return false;
+
+    // Never queue writes, if the disk can't keep up we skip snapshots instead of stalling the tick
+    if (m_pendingWrite.valid() && m_pendingWrite.wait_for(0s) != std::future_status::ready)
+        return false;
+
+    m_pendingEntities.clear();
+    m_world.each([this](auto aEntity) {
+        if (m_world.any<SNAPSHOT_COMPONENTS>(aEntity))
+            m_pendingEntities.push_back(aEntity);
+    });
+
+    m_data.clear();
+    m_data.reserve(1 << 20);
+
+    WriteRaw(m_data, cSnapshotMagic);
+    WriteRaw(m_data, cSnapshotVersion);
+    // Patched with the number of records once they are all written
+    WriteRaw(m_data, uint32_t{ 0 });
+
+    m_nextEntity = 0;
+    m_entityCount = 0;
+    m_saving = true;
+
+    return true;
+}
+
+void SnapshotService::OnUpdate(const UpdateEvent&) noexcept
+{
+    if (!m_saving)
+        return;
+
+    // Records are spread over as many ticks as needed, each tick only gets a fixed slice of time and entities
+    const auto cDeadline = std::chrono::steady_clock::now() + cSnapshotBudget;
+    const auto cEnd = std::min(m_pendingEntities.size(), m_nextEntity + cSnapshotEntitiesPerTick);
+
+    while (m_nextEntity < cEnd && std::chrono::steady_clock::now() < cDeadline)
+    {
+        const auto cEntity = m_pendingEntities[m_nextEntity++];
+
+        // Destroyed since the snapshot started, anything created since is picked up by the next one
+        if (!m_world.valid(cEntity) || !m_world.any<SNAPSHOT_COMPONENTS>(cEntity))
+            continue;
+
+        SaveEntity<SNAPSHOT_COMPONENTS>(m_world, cEntity, m_data, m_scratch);
+        ++m_entityCount;
+    }
+
+    if (m_nextEntity < m_pendingEntities.size())
+        return;
+
+    std::memcpy(m_data.data() + 2 * sizeof(uint32_t), &m_entityCount, sizeof(m_entityCount));
+
+    const auto state = SerializeState();
+    WriteRaw(m_data, static_cast<uint32_t>(state.size()));
+    m_data.insert(std::end(m_data), std::begin(state), std::end(state));
+
+    m_pendingWrite = std::async(std::launch::async, WriteFile, m_path, std::move(m_data));
+
+    m_data = {};
+    m_pendingEntities.clear();
+    m_saving = false;
+}
+
+bool SnapshotService::Restore() noexcept
+{
+    std::ifstream file(m_path, std::ios::binary | std::ios::ate);
+    if (!file)
+    {
+        spdlog::warn("No world snapshot to restore at {}", m_path.string());
+        return false;
+    }
+
+    std::vector<uint8_t> data(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(data.data()), data.size());
+
+    SnapshotReader reader(data.data(), data.size());
+
+    uint32_t magic = 0, version = 0, entityCount = 0;
+    reader.ReadRaw(magic);
+    reader.ReadRaw(version);
+
+    if (magic != cSnapshotMagic || version != cSnapshotVersion)
+    {
+        spdlog::error("{} is not a compatible world snapshot", m_path.string());
+        return false;
+    }
+
+    reader.ReadRaw(entityCount);
+
+    auto valid = reader.IsValid();
+    for (auto i = 0u; valid && i < entityCount; ++i)
+        valid = LoadEntity<SNAPSHOT_COMPONENTS>(m_world, reader);
+
+    uint32_t stateSize = 0;
+    reader.ReadRaw(stateSize);
+
+    const auto* pState = reader.Consume(stateSize);
+
+    if (!valid || !pState)
+    {
+        spdlog::error("World snapshot {} is truncated", m_path.string());
+
+        m_world.clear();
+        return false;
+    }
+
+    DeserializeState(pState, stateSize);
+
+    // Player characters are recreated by their owners when they join again, only form backed entities can be adopted
+    auto playerCharacterView = m_world.view<OwnerComponent>(entt::exclude<FormIdComponent>);
+    m_world.destroy(std::begin(playerCharacterView), std::end(playerCharacterView));
+
+    spdlog::info("Restored {} entities from {}", m_world.alive(), m_path.string());
+
+    m_world.GetTimerService().SetTimeout(cOrphanTimeout, [this]() { DestroyOrphans(); });
+
+    return true;
+}
+
+void SnapshotService::DestroyOrphans() noexcept
+{
+    Vector<entt::entity> orphans;
+
+    auto ownerView = m_world.view<OwnerComponent>();
+    for (auto entity : ownerView)
+    {
+        if (ownerView.get<OwnerComponent>(entity).IsOrphaned())
+            orphans.push_back(entity);
+    }
+
+    if (orphans.empty())
+        return;
+
+    // Players may have been sent them with a cell, take them out there as well
+    for (auto entity : orphans)
+    {
+        NotifyRemoveCharacter message;
+        message.ServerId = World::ToInteger(entity);
+
+        GameServer::Get()->SendToPlayers(message);
+    }
+
+    m_world.destroy(std::begin(orphans), std::end(orphans));
+
+    spdlog::info("Destroyed {} restored entities nobody adopted", orphans.size());
+}
+
+std::vector<uint8_t> SnapshotService::SerializeState() const noexcept
+{
+    Buffer buffer(1 << 20);
+    Buffer::Writer writer(&buffer);
+
+    const auto& modEntries = m_world.ctx<ModsComponent>().GetEntries();
+    for (const auto cLite : {false, true})
+    {
+        const auto cCount = std::count_if(std::begin(modEntries), std::end(modEntries), [cLite](const auto& acEntry) {
+            return acEntry.Used && acEntry.Lite == cLite;
+        });
+
+        Serialization::WriteVarInt(writer, cCount);
+        for (auto id = 0u; id < modEntries.size(); ++id)
+        {
+            const auto& entry = modEntries[id];
+            if (!entry.Used || entry.Lite != cLite)
+                continue;
+
+            Serialization::WriteString(writer, entry.Filename);
+            Serialization::WriteVarInt(writer, id);
+        }
+    }
+
+    const auto& parties = m_world.ctx<PartyService>().GetParties();
+    Serialization::WriteVarInt(writer, parties.size());
+    for (const auto& [id, party] : parties)
+    {
+        Serialization::WriteVarInt(writer, party.Members.size());
+        for (auto member : party.Members)
+        {
+            const auto* pPlayerComponent = m_world.try_get<PlayerComponent>(member);
+            Serialization::WriteString(writer, pPlayerComponent ? pPlayerComponent->GetPersistentKey() : String{});
+        }
+    }
+
+    // Epoch ticks don't survive a restart, store the time it is now
+    const auto& environmentService = m_world.GetEnvironmentService();
+    Serialization::WriteVarInt(writer, environmentService.GetGameTime());
+    Serialization::WriteVarInt(writer, environmentService.GetTimeModel().Rate);
+
+    return std::vector<uint8_t>(buffer.GetData(), buffer.GetData() + writer.Size());
+}
+
+void SnapshotService::DeserializeState(const uint8_t* apData, size_t aSize) noexcept
+{
+    Buffer buffer(apData, aSize);
+    Buffer::Reader reader(&buffer);
+
+    auto& mods = m_world.ctx<ModsComponent>();
+    for (const auto cLite : {false, true})
+    {
+        const auto cCount = Serialization::ReadVarInt(reader);
+        for (auto i = 0u; i < cCount; ++i)
+        {
+            const auto filename = Serialization::ReadString(reader);
+            const auto cId = Serialization::ReadVarInt(reader) & 0xFFFFFFFF;
+
+            mods.Restore(filename, cId, cLite);
+        }
+    }
+
+    auto& partyService = m_world.ctx<PartyService>();
+    const auto cPartyCount = Serialization::ReadVarInt(reader);
+    for (auto i = 0u; i < cPartyCount; ++i)
+    {
+        Vector<String> memberKeys(Serialization::ReadVarInt(reader));
+        for (auto& key : memberKeys)
+            key = Serialization::ReadString(reader);
+
+        partyService.RestoreParty(std::move(memberKeys));
+    }
+
+    const auto cGameTime = Serialization::ReadVarInt(reader);
+    const auto cRate = Serialization::ReadVarInt(reader) & 0xFFFFFFFF;
+
+    m_world.GetEnvironmentService().RestoreTime(cGameTime, cRate);
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <future>
+
+struct World;
+struct UpdateEvent;
+
+struct SnapshotService
+{
+    SnapshotService(World& aWorld, entt::dispatcher& aDispatcher) noexcept;
+    ~SnapshotService() noexcept;
+
+    TP_NOCOPYMOVE(SnapshotService);
+
+    // Starts snapshotting the world to acPath periodically, optionally loading the previous snapshot first
+    void Initialize(const String& acPath, bool aRestore) noexcept;
+
+    // Starts a snapshot, entities are encoded a bounded slice per tick and the file is written once all are done
+    bool Save() noexcept;
+    bool Restore() noexcept;
+
+protected:
+
+    void OnUpdate(const UpdateEvent& acEvent) noexcept;
+
+private:
+
+    // Restored entities stay orphaned until a client sends an AssignCharacterRequest for their form, the ones still
+    // orphaned a while after the restore are destroyed
+    void DestroyOrphans() noexcept;
+
+    [[nodiscard]] std::vector<uint8_t> SerializeState() const noexcept;
+    void DeserializeState(const uint8_t* apData, size_t aSize) noexcept;
+
+    World& m_world;
+
+    std::filesystem::path m_path;
+    std::future<void> m_pendingWrite;
+
+    // Snapshot in progress
+    bool m_saving{ false };
+    std::vector<entt::entity> m_pendingEntities;
+    size_t m_nextEntity{ 0 };
+    uint32_t m_entityCount{ 0 };
+    std::vector<uint8_t> m_data;
+    Buffer m_scratch;
+
+    entt::scoped_connection m_updateConnection;
+};
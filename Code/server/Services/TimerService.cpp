@@ -0,0 +1,46 @@
+#include <stdafx.h>
+
+#include <Services/TimerService.h>
+#include <World.h>
+
+#include <Events/UpdateEvent.h>
+
+TimerService::TimerService(World& aWorld, entt::dispatcher& aDispatcher) noexcept
+    : m_start(std::chrono::steady_clock::now())
+    , m_updateConnection(aDispatcher.sink<UpdateEvent>().connect<&TimerService::OnUpdate>(this))
+{
+}
+
+TimerService::TimerId TimerService::SetTimeout(std::chrono::milliseconds aDelay, std::function<void()> aCallback) noexcept
+{
+    return m_wheel.Schedule(ToWheelTicks(aDelay), std::move(aCallback));
+}
+
+TimerService::TimerId TimerService::SetInterval(std::chrono::milliseconds aInterval, std::function<void()> aCallback) noexcept
+{
+    return m_wheel.ScheduleRepeating(ToWheelTicks(aInterval), std::move(aCallback));
+}
+
+void TimerService::Cancel(TimerId aId) noexcept
+{
+    m_wheel.Cancel(aId);
+}
+
+void TimerService::OnUpdate(const UpdateEvent& acEvent) noexcept
+{
+    m_wheel.Advance(GetWheelTicks());
+}
+
+uint64_t TimerService::GetWheelTicks() const noexcept
+{
+    const auto cElapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_start);
+
+    return cElapsed / kResolution;
+}
+
+uint64_t TimerService::ToWheelTicks(std::chrono::milliseconds aDuration) noexcept
+{
+    const auto cDuration = std::max(aDuration, std::chrono::milliseconds::zero());
+
+    return (cDuration.count() + kResolution.count() - 1) / kResolution.count();
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <common/TimerWheel.h>
+
+struct World;
+struct UpdateEvent;
+
+struct TimerService
+{
+    using TimerId = TimerWheel::TimerId;
+
+    static constexpr TimerId kInvalidTimer = TimerWheel::kInvalidTimer;
+
+    TimerService(World& aWorld, entt::dispatcher& aDispatcher) noexcept;
+    ~TimerService() noexcept = default;
+
+    TP_NOCOPYMOVE(TimerService);
+
+    // Callbacks run on the simulation thread at the start of the first update past their deadline
+    TimerId SetTimeout(std::chrono::milliseconds aDelay, std::function<void()> aCallback) noexcept;
+    TimerId SetInterval(std::chrono::milliseconds aInterval, std::function<void()> aCallback) noexcept;
+    void Cancel(TimerId aId) noexcept;
+
+    [[nodiscard]] size_t GetCount() const noexcept { return m_wheel.GetCount(); }
+
+protected:
+
+    void OnUpdate(const UpdateEvent& acEvent) noexcept;
+
+private:
+
+    // Deadlines are rounded up to this, finer than any server tick so timers never fire late by more than a frame
+    static constexpr std::chrono::milliseconds kResolution{ 10 };
+
+    [[nodiscard]] uint64_t GetWheelTicks() const noexcept;
+    [[nodiscard]] static uint64_t ToWheelTicks(std::chrono::milliseconds aDuration) noexcept;
+
+    TimerWheel m_wheel;
+    std::chrono::steady_clock::time_point m_start;
+
+    entt::scoped_connection m_updateConnection;
+};
@@ -0,0 +1,78 @@
+#include <stdafx.h>
+
+#include <TickRateController.h>
+
+namespace
+{
+// Fraction of the frame budget above which we slow down, and below which we can afford to speed up
+constexpr float cHighLoad = 0.75f;
+constexpr float cLowLoad = 0.3f;
+
+// Inbound messages per frame considered a backlog, the pipeline is falling behind past that point
+constexpr float cQueueBacklog = 256.f;
+
+// Player count at which the full rate is allowed, fewer players don't need as many updates
+constexpr size_t cPlayersForMaxRate = 8;
+
+// Only step once per period so the rate doesn't oscillate with every spike
+constexpr auto cAdjustmentPeriod = 1s;
+constexpr float cSmoothing = 0.1f;
+}
+
+TickRateController::TickRateController(uint32_t aMinTickRate, uint32_t aMaxTickRate) noexcept
+    : m_minTickRate(std::max(1u, std::min(aMinTickRate, aMaxTickRate)))
+    , m_maxTickRate(std::max(1u, std::max(aMinTickRate, aMaxTickRate)))
+    , m_tickRate(m_maxTickRate)
+{
+    spdlog::info("Adaptive tick rate between {} and {} Hz", m_minTickRate, m_maxTickRate);
+}
+
+bool TickRateController::ShouldRun(Clock::time_point aNow) noexcept
+{
+    if (aNow < m_nextFrame)
+        return false;
+
+    const auto cInterval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(1.f / m_tickRate));
+
+    // Don't try to catch up on missed frames, that is what falling behind looks like
+    m_nextFrame = std::max(m_nextFrame + cInterval, aNow);
+
+    return true;
+}
+
+void TickRateController::Report(Clock::time_point aNow, Clock::duration aFrameTime, size_t aQueuedMessages, size_t aPlayerCount) noexcept
+{
+    const auto cFrameTime = std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(aFrameTime).count();
+
+    m_averageFrameTime += (cFrameTime - m_averageFrameTime) * cSmoothing;
+    m_averageQueuedMessages += (static_cast<float>(aQueuedMessages) - m_averageQueuedMessages) * cSmoothing;
+
+    if (aNow < m_nextAdjustment)
+        return;
+
+    m_nextAdjustment = aNow + cAdjustmentPeriod;
+
+    const auto cLoad = m_averageFrameTime * m_tickRate / 1000.f;
+
+    const auto cPlayerRatio = std::min(1.f, static_cast<float>(aPlayerCount) / cPlayersForMaxRate);
+    const auto cCeiling = m_minTickRate + static_cast<uint32_t>((m_maxTickRate - m_minTickRate) * cPlayerRatio);
+
+    auto tickRate = m_tickRate;
+
+    if (cLoad > cHighLoad || m_averageQueuedMessages > cQueueBacklog)
+        tickRate = static_cast<uint32_t>(tickRate * 0.8f);
+    else if (tickRate > cCeiling)
+        tickRate = std::max(cCeiling, static_cast<uint32_t>(tickRate * 0.8f));
+    else if (cLoad < cLowLoad)
+        tickRate = std::min(cCeiling, std::max(tickRate + 1, static_cast<uint32_t>(tickRate * 1.2f)));
+
+    tickRate = std::clamp(tickRate, m_minTickRate, m_maxTickRate);
+
+    if (tickRate == m_tickRate)
+        return;
+
+    spdlog::info("Tick rate {} -> {} Hz (frame {:.2f}ms, {:.0f} queued messages, {} players)", m_tickRate, tickRate,
+                 m_averageFrameTime, m_averageQueuedMessages, aPlayerCount);
+
+    m_tickRate = tickRate;
+}
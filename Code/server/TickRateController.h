@@ -0,0 +1,31 @@
+#pragma once
+
+// Picks how often the simulation runs from the load of the previous frames, between fixed bounds
+struct TickRateController
+{
+    using Clock = std::chrono::steady_clock;
+
+    TickRateController(uint32_t aMinTickRate, uint32_t aMaxTickRate) noexcept;
+    ~TickRateController() noexcept = default;
+
+    TP_NOCOPYMOVE(TickRateController);
+
+    [[nodiscard]] uint32_t GetTickRate() const noexcept { return m_tickRate; }
+
+    // True once a full interval at the current rate has elapsed since the last frame
+    [[nodiscard]] bool ShouldRun(Clock::time_point aNow) noexcept;
+
+    void Report(Clock::time_point aNow, Clock::duration aFrameTime, size_t aQueuedMessages, size_t aPlayerCount) noexcept;
+
+private:
+
+    uint32_t m_minTickRate;
+    uint32_t m_maxTickRate;
+    uint32_t m_tickRate;
+
+    float m_averageFrameTime{ 0.f };
+    float m_averageQueuedMessages{ 0.f };
+
+    Clock::time_point m_nextFrame{};
+    Clock::time_point m_nextAdjustment{};
+};
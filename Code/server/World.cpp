@@ -10,9 +10,16 @@
 #include <Services/ServerListService.h>
 #include <Services/PartyService.h>
 #include <Services/ActorService.h>
+#include <Services/PersistenceService.h>
+#include <Services/SnapshotService.h>
+#include <Services/TimerService.h>
 
 World::World()
+    // Leave a core for the simulation thread, it takes part in every job anyway
+    : m_pJobPool(std::make_unique<JobPool>(std::max(2u, std::thread::hardware_concurrency()) - 1))
 {
+    // First so every other service can schedule timers from its constructor, and so timers fire before their updates
+    set<TimerService>(*this, m_dispatcher);
     set<CharacterService>(*this, m_dispatcher);
     set<PlayerService>(*this, m_dispatcher);
     set<EnvironmentService>(*this, m_dispatcher);
@@ -21,6 +28,8 @@ World::World()
     set<QuestService>(*this, m_dispatcher);
     set<PartyService>(*this, m_dispatcher);
     set<ActorService>(*this, m_dispatcher);
+    set<PersistenceService>(*this, m_dispatcher);
+    set<SnapshotService>(*this, m_dispatcher);
 
     // late initialize the ScriptService to ensure all components are valid
     m_scriptService = std::make_unique<ScriptService>(*this, m_dispatcher);
@@ -5,6 +5,9 @@
 #include <Services/CharacterService.h>
 #include <Services/EnvironmentService.h>
 #include <Services/QuestService.h>
+#include <Services/TimerService.h>
+
+#include <common/JobPool.h>
 
 struct World : entt::registry
 {
@@ -25,11 +28,16 @@ struct World : entt::registry
     const EnvironmentService& GetEnvironmentService() const noexcept { return ctx<EnvironmentService>(); }
     QuestService& GetQuestService() noexcept { return ctx<QuestService>(); }
     const QuestService& GetQuestService() const noexcept { return ctx<QuestService>(); }
+    TimerService& GetTimerService() noexcept { return ctx<TimerService>(); }
+    const TimerService& GetTimerService() const noexcept { return ctx<TimerService>(); }
+    JobPool& GetJobPool() const noexcept { return *m_pJobPool; }
 
     [[nodiscard]] static uint32_t ToInteger(entt::entity aEntity) { return to_integral(aEntity); }
 
 private:
     entt::dispatcher m_dispatcher;
 
+    std::unique_ptr<JobPool> m_pJobPool;
+
     std::unique_ptr<ScriptService> m_scriptService;
 };
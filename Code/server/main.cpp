@@ -7,7 +7,9 @@
 
 #include <cxxopts.hpp>
 #include <filesystem>
+#include <thread>
 #include <GameServer.h>
+#include <PacketReplayer.h>
 
 int main(int argc, char** argv)
 {
@@ -32,15 +34,40 @@ int main(int argc, char** argv)
         );
 
     uint16_t port = 10578;
+    uint32_t decodeThreads = 2;
+    uint32_t movementHistory = 32;
+    uint16_t metricsPort = 0;
+    uint32_t statsLogInterval = 60;
+    uint32_t idleSleep = 250;
+    uint32_t minTickRate = 10, maxTickRate = 60;
+    bool adaptiveTickRate = false;
     bool premium = false;
-    std::string name, token, logLevel;
+    bool hotReload = false;
+    bool restore = false;
+    bool replayMaxSpeed = false;
+    std::string name, token, logLevel, database, snapshot, record, replay;
 
     options.add_options()
         ("p,port", "port to run on", cxxopts::value<uint16_t>(port)->default_value("10578"), "N")
         ("premium", "Use the premium tick rates", cxxopts::value<bool>(premium)->default_value("false"), "true/false")
+        ("hot-reload", "Reload scripts when they change on disk", cxxopts::value<bool>(hotReload)->default_value("false"), "true/false")
         ("h,help", "Display the help message")
         ("n,name", "Name to advertise to the public server list", cxxopts::value<>(name))
         ("l,log", "Log level.", cxxopts::value<>(logLevel)->default_value("info"), "trace/debug/info/warning/error/critical/off")
+        ("d,database", "SQLite file used to persist player state, disabled when empty", cxxopts::value<>(database))
+        ("snapshot", "File the world is periodically snapshotted to, disabled when empty", cxxopts::value<>(snapshot))
+        ("restore", "Restore the world from the snapshot file on startup", cxxopts::value<bool>(restore)->default_value("false"), "true/false")
+        ("adaptive-tick-rate", "Scale the tick rate with load instead of always running at the hosted rate", cxxopts::value<bool>(adaptiveTickRate)->default_value("false"), "true/false")
+        ("min-tick-rate", "Lowest adaptive tick rate", cxxopts::value<uint32_t>(minTickRate)->default_value("10"), "N")
+        ("max-tick-rate", "Highest adaptive tick rate, capped by the hosted rate", cxxopts::value<uint32_t>(maxTickRate)->default_value("60"), "N")
+        ("idle-sleep", "Milliseconds to sleep between updates while nobody is connected, 0 always runs at the tick rate", cxxopts::value<uint32_t>(idleSleep)->default_value("250"), "N")
+        ("movement-history", "Movement samples kept per actor for lag compensation, 0 disables it", cxxopts::value<uint32_t>(movementHistory)->default_value("32"), "N")
+        ("metrics-port", "Port serving per connection network metrics in the Prometheus format on /metrics, 0 disables it", cxxopts::value<uint16_t>(metricsPort)->default_value("0"), "N")
+        ("stats-log-interval", "Seconds between network statistics log lines, 0 disables them", cxxopts::value<uint32_t>(statsLogInterval)->default_value("60"), "N")
+        ("decode-threads", "Worker threads decoding inbound packets, 0 decodes on the simulation thread", cxxopts::value<uint32_t>(decodeThreads)->default_value("2"), "N")
+        ("record", "File all inbound traffic is recorded to", cxxopts::value<>(record))
+        ("replay", "Run headless and replay a recorded session instead of listening", cxxopts::value<>(replay))
+        ("replay-max-speed", "Replay as fast as possible instead of in real time", cxxopts::value<bool>(replayMaxSpeed)->default_value("false"), "true/false")
         ("t,token", "The token required to connect to the server, acts as a password", cxxopts::value<>(token));
 
     try
@@ -60,12 +87,47 @@ int main(int argc, char** argv)
             throw std::runtime_error("A named server cannot have a token set !");
         }
 
-        GameServer server(port, premium, name.c_str(), token.c_str());
+        GameServer server(port, premium, name.c_str(), token.c_str(), !replay.empty());
         // things that need initialization post construction
-        server.Initialize();
+        server.Initialize(hotReload, database.c_str(), snapshot.c_str(), restore);
+        server.SetMovementHistoryLength(movementHistory);
 
-        while(server.IsListening())
-            server.Update();
+        if (!replay.empty())
+        {
+            PacketReplayer replayer(server, replay.c_str());
+            replayer.Run(!replayMaxSpeed);
+        }
+        else
+        {
+            if (!record.empty())
+                server.StartRecording(record.c_str());
+
+            if (decodeThreads > 0)
+                server.StartDecodeWorkers(decodeThreads);
+
+            server.ConfigureNetworkStats(metricsPort, statsLogInterval);
+
+            if (adaptiveTickRate)
+                server.EnableAdaptiveTickRate(minTickRate, maxTickRate);
+
+            bool idle = false;
+
+            while(server.IsListening())
+            {
+                server.Update();
+
+                // Connections are accepted by the transport in the background, the first one is picked up by the next update
+                const auto cIdle = idleSleep > 0 && server.IsIdle();
+                if (cIdle != idle)
+                {
+                    idle = cIdle;
+                    spdlog::info(idle ? "Nobody connected, idling" : "Client connected, resuming full tick rate");
+                }
+
+                if (idle)
+                    std::this_thread::sleep_for(std::chrono::milliseconds(idleSleep));
+            }
+        }
     }
     catch (const cxxopts::OptionException& e)
     {
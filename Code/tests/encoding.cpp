@@ -7,10 +7,24 @@
 #include <Messages/CancelAssignmentRequest.h>
 #include <Messages/RemoveCharacterRequest.h>
 #include <Messages/AssignCharacterRequest.h>
+#include <Messages/ServerScriptUpdate.h>
+#include <Messages/ServerReferencesMoveRequest.h>
+#include <Messages/NotifyActorValueChanges.h>
+#include <Messages/NotifyCharacterSpawnBatch.h>
+#include <Messages/NotifyPartyMemberStates.h>
+#include <Messages/NotifyPlayerList.h>
+#include <Messages/NotifyPlayerJoined.h>
+#include <Messages/NotifyPlayerLeft.h>
+#include <Messages/NotifyQuestUpdateBatch.h>
+#include <Messages/ServerMessageBundle.h>
+#include <Messages/ServerMessageFactory.h>
+#include <Messages/ServerTimeSettings.h>
 #include <Structs/ActionEvent.h>
+#include <Structs/ActorValues.h>
 #include <Structs/Mods.h>
 #include <Structs/FullObjects.h>
 #include <Structs/Objects.h>
+#include <Structs/QuestLog.h>
 #include <Structs/Scripts.h>
 #include <Structs/GameId.h>
 #include <Structs/Vector3_NetQuantize.h>
@@ -18,6 +32,7 @@
 #include <Structs/Rotator2_NetQuantize.h>
   
 #include <TiltedCore/Math.hpp>
+#include <TiltedCore/ViewBuffer.hpp>
 
 using namespace TiltedPhoques;
 
@@ -121,6 +136,39 @@ TEST_CASE("Static structures", "[encoding.static]")
         }
     }
 
+    GIVEN("QuestLog")
+    {
+        QuestLog sendObjects, recvObjects;
+        sendObjects.Set(GameId(3, 0x1234), 10);
+        sendObjects.Set(GameId(0, 0x3372B), 200);
+        sendObjects.Set(GameId(3, 0x1200), 0);
+        sendObjects.Set(GameId(250, 0xFFFFFF), 65535);
+
+        REQUIRE(!sendObjects.Set(GameId(3, 0x1234), 10));
+        REQUIRE(sendObjects.Set(GameId(3, 0x1234), 20));
+        REQUIRE(sendObjects.Find(GameId(3, 0x1234))->Stage == 20);
+        REQUIRE(sendObjects.FindByBaseId(0x3372B)->Stage == 200);
+
+        REQUIRE(sendObjects.Remove(GameId(0, 0x3372B)));
+        REQUIRE(!sendObjects.Remove(GameId(0, 0x3372B)));
+        REQUIRE(sendObjects.Find(GameId(0, 0x3372B)) == nullptr);
+        REQUIRE(sendObjects.Find(GameId(250, 0xFFFFFF))->Stage == 65535);
+        REQUIRE(sendObjects.size() == 3);
+
+        {
+            Buffer buff(1000);
+            Buffer::Writer writer(&buff);
+
+            sendObjects.Serialize(writer);
+
+            Buffer::Reader reader(&buff);
+            recvObjects.Deserialize(reader);
+
+            REQUIRE(sendObjects == recvObjects);
+            REQUIRE(recvObjects.Find(GameId(3, 0x1200))->Stage == 0);
+        }
+    }
+
     GIVEN("Vector3_NetQuantize")
     {
         Vector3_NetQuantize sendObjects, recvObjects;
@@ -314,6 +362,30 @@ TEST_CASE("Differential structures", "[encoding.differential]")
             REQUIRE(vars.Integers == recvVars.Integers);
         }
     }
+
+    GIVEN("ActorValues")
+    {
+        ActorValues values, recvValues;
+        values.ActorValuesList[24] = 250.f;
+        values.ActorValuesList[25] = 100.5f;
+        values.ActorValuesList[26] = 1234.567f;
+        values.ActorValuesList[ActorValueList::kCapacity] = 1.f;
+        values.ActorMaxValuesList[24] = 300.f;
+
+        REQUIRE(values.ActorValuesList.size() == 3);
+
+        Buffer buff(1000);
+        {
+            Buffer::Writer writer(&buff);
+
+            values.Serialize(writer);
+
+            Buffer::Reader reader(&buff);
+            recvValues.Deserialize(reader);
+
+            REQUIRE(values == recvValues);
+        }
+    }
 }
 
 TEST_CASE("Packets", "[encoding.packets]")
@@ -451,6 +523,356 @@ TEST_CASE("Packets", "[encoding.packets]")
         REQUIRE(sendMessage == recvMessage);
     }
 
+    SECTION("ServerScriptUpdate")
+    {
+        {
+            Buffer buff(1000);
+
+            ServerScriptUpdate sendMessage, recvMessage;
+            sendMessage.Data.Data.push_back(42);
+            sendMessage.Data.Data.push_back(13);
+
+            Buffer::Writer writer(&buff);
+            sendMessage.Serialize(writer);
+
+            Buffer::Reader reader(&buff);
+
+            uint64_t trash;
+            reader.ReadBits(trash, 8); // pop opcode
+
+            recvMessage.DeserializeRaw(reader);
+
+            REQUIRE(sendMessage == recvMessage);
+        }
+
+        {
+            Buffer buff(1000);
+
+            ServerScriptUpdate sendMessage, recvMessage;
+            sendMessage.Reload = true;
+            sendMessage.Definitions.Data.push_back(1);
+            sendMessage.Definitions.Data.push_back(2);
+            sendMessage.ReplicatedObjects.Data.push_back(3);
+
+            Buffer::Writer writer(&buff);
+            sendMessage.Serialize(writer);
+
+            Buffer::Reader reader(&buff);
+
+            uint64_t trash;
+            reader.ReadBits(trash, 8); // pop opcode
+
+            recvMessage.DeserializeRaw(reader);
+
+            REQUIRE(sendMessage == recvMessage);
+        }
+    }
+
+    SECTION("NotifyCharacterSpawnBatch")
+    {
+        Buffer buff(1000);
+
+        NotifyCharacterSpawnBatch sendMessage, recvMessage;
+
+        auto& first = sendMessage.Spawns.emplace_back();
+        first.ServerId = 42;
+        first.FormId.BaseId = 0x1234;
+        first.FormId.ModId = 3;
+        first.Position.x = -452.4f;
+        first.Position.y = 452.4f;
+        first.Position.z = 125452.4f;
+        first.AppearanceBuffer = "toto";
+
+        auto& second = sendMessage.Spawns.emplace_back();
+        second.ServerId = 1337;
+        second.BaseId.BaseId = 0x7;
+        second.ChangeFlags = 0x1F;
+
+        // A state encoded ahead of time decodes to the same fields
+        auto& third = sendMessage.Spawns.emplace_back();
+        third.ServerId = 7;
+        third.Position.x = 12.3f;
+        third.ChangeFlags = 0x3;
+        third.AppearanceBuffer = "cached";
+
+        const auto expected = sendMessage;
+
+        Buffer stateBuff(1000);
+        Buffer::Writer stateWriter(&stateBuff);
+        CharacterSpawnRequest::SerializeState(stateWriter, third.ChangeFlags, third.AppearanceBuffer, third.InventoryContent,
+                                              third.FactionsContent, third.FaceTints, third.InitialActorValues);
+
+        third.EncodedState = std::make_shared<const std::vector<uint8_t>>(stateBuff.GetWriteData(), stateBuff.GetWriteData() + stateWriter.Size());
+        third.ChangeFlags = 0;
+        third.AppearanceBuffer.clear();
+
+        Buffer::Writer writer(&buff);
+        sendMessage.Serialize(writer);
+
+        Buffer::Reader reader(&buff);
+
+        uint64_t trash;
+        reader.ReadBits(trash, 8); // pop opcode
+
+        recvMessage.DeserializeRaw(reader);
+
+        REQUIRE(expected == recvMessage);
+    }
+
+    SECTION("NotifyPartyMemberStates")
+    {
+        Buffer buff(1000);
+
+        NotifyPartyMemberStates sendMessage, recvMessage;
+
+        auto& first = sendMessage.Members.emplace_back();
+        first.PlayerId = 12;
+        first.CellId.BaseId = 0x3C;
+        first.CellId.ModId = 1;
+        first.Position.x = -452.4f;
+        first.Position.y = 452.4f;
+        first.Position.z = 125452.4f;
+        first.Health = 75.5f;
+        first.MaxHealth = 200.f;
+
+        auto& second = sendMessage.Members.emplace_back();
+        second.PlayerId = 1337;
+        second.Position.x = 12.f;
+        second.Position.y = 0.f;
+        second.Position.z = -7.f;
+        second.Health = 10.f;
+
+        Buffer::Writer writer(&buff);
+        sendMessage.Serialize(writer);
+
+        Buffer::Reader reader(&buff);
+
+        uint64_t trash;
+        reader.ReadBits(trash, 8); // pop opcode
+
+        recvMessage.DeserializeRaw(reader);
+
+        REQUIRE(sendMessage == recvMessage);
+        REQUIRE(sendMessage.GetDeliveryClass() == kUnreliableSequenced);
+    }
+
+    SECTION("Player list")
+    {
+        {
+            Buffer buff(1000);
+
+            NotifyPlayerList sendMessage, recvMessage;
+            sendMessage.Version = 7;
+            sendMessage.Players[1] = "Fjotra";
+            sendMessage.Players[42] = "Ulfric";
+
+            Buffer::Writer writer(&buff);
+            sendMessage.Serialize(writer);
+
+            Buffer::Reader reader(&buff);
+
+            uint64_t trash;
+            reader.ReadBits(trash, 8); // pop opcode
+
+            recvMessage.DeserializeRaw(reader);
+
+            REQUIRE(sendMessage == recvMessage);
+        }
+
+        {
+            Buffer buff(1000);
+
+            NotifyPlayerJoined sendMessage, recvMessage;
+            sendMessage.Version = 8;
+            sendMessage.PlayerId = 1337;
+            sendMessage.Username = "Lydia";
+
+            Buffer::Writer writer(&buff);
+            sendMessage.Serialize(writer);
+
+            Buffer::Reader reader(&buff);
+
+            uint64_t trash;
+            reader.ReadBits(trash, 8); // pop opcode
+
+            recvMessage.DeserializeRaw(reader);
+
+            REQUIRE(sendMessage == recvMessage);
+        }
+
+        {
+            Buffer buff(1000);
+
+            NotifyPlayerLeft sendMessage, recvMessage;
+            sendMessage.Version = 9;
+            sendMessage.PlayerId = 42;
+
+            Buffer::Writer writer(&buff);
+            sendMessage.Serialize(writer);
+
+            Buffer::Reader reader(&buff);
+
+            uint64_t trash;
+            reader.ReadBits(trash, 8); // pop opcode
+
+            recvMessage.DeserializeRaw(reader);
+
+            REQUIRE(sendMessage == recvMessage);
+        }
+    }
+
+    SECTION("NotifyQuestUpdateBatch")
+    {
+        Buffer buff(1000);
+
+        NotifyQuestUpdateBatch sendMessage, recvMessage;
+
+        auto& first = sendMessage.Updates.emplace_back();
+        first.Id = GameId(2, 0x4567);
+        first.Status = NotifyQuestUpdate::Started;
+        first.Stage = 0;
+
+        auto& second = sendMessage.Updates.emplace_back();
+        second.Id = GameId(0, 0x3372B);
+        second.Status = NotifyQuestUpdate::StageUpdate;
+        second.Stage = 150;
+
+        Buffer::Writer writer(&buff);
+        sendMessage.Serialize(writer);
+
+        Buffer::Reader reader(&buff);
+
+        uint64_t trash;
+        reader.ReadBits(trash, 8); // pop opcode
+
+        recvMessage.DeserializeRaw(reader);
+
+        REQUIRE(sendMessage == recvMessage);
+    }
+
+    SECTION("ServerTimeSettings")
+    {
+        Buffer buff(1000);
+
+        ServerTimeSettings sendMessage, recvMessage;
+        sendMessage.GameTime = 12ull * 3600 * 1000 + 365ull * 24 * 3600 * 1000 * 7;
+        sendMessage.EpochTick = 1234567890123;
+        sendMessage.Rate = 20000;
+
+        Buffer::Writer writer(&buff);
+        sendMessage.Serialize(writer);
+
+        Buffer::Reader reader(&buff);
+
+        uint64_t trash;
+        reader.ReadBits(trash, 8); // pop opcode
+
+        recvMessage.DeserializeRaw(reader);
+
+        REQUIRE(sendMessage == recvMessage);
+    }
+
+    SECTION("NotifyActorValueChanges")
+    {
+        Buffer buff(1000);
+
+        NotifyActorValueChanges sendMessage, recvMessage;
+        sendMessage.Id = 42;
+        sendMessage.Values[24] = 250.f;
+        sendMessage.Values[25] = 100.5f;
+        sendMessage.Values[26] = 80.f;
+
+        {
+            // Nothing sent before, everything goes out
+            Buffer::Writer writer(&buff);
+            sendMessage.Serialize(writer);
+
+            Buffer::Reader reader(&buff);
+
+            uint64_t trash;
+            reader.ReadBits(trash, 8); // pop opcode
+
+            recvMessage.DeserializeRaw(reader);
+
+            REQUIRE(sendMessage == recvMessage);
+        }
+
+        sendMessage.Previous = sendMessage.Values;
+        sendMessage.Values[24] = 12.f;
+        sendMessage.Values[0] = -3.f;
+
+        {
+            Buffer::Writer writer(&buff);
+            sendMessage.Serialize(writer);
+
+            Buffer::Reader reader(&buff);
+
+            uint64_t trash;
+            reader.ReadBits(trash, 8); // pop opcode
+
+            recvMessage.DeserializeRaw(reader);
+
+            // Only what differs from the previous state is received
+            REQUIRE(recvMessage.Id == 42);
+            REQUIRE(recvMessage.Values.size() == 2);
+            REQUIRE(recvMessage.Values[24] == 12.f);
+            REQUIRE(recvMessage.Values[0] == -3.f);
+            REQUIRE_FALSE(recvMessage.Values.contains(25));
+
+            // Applied on top of the previous state it gives back the full state
+            auto values = sendMessage.Previous;
+            for (auto& [id, value] : recvMessage.Values)
+                values[id] = value;
+
+            REQUIRE(values == sendMessage.Values);
+            REQUIRE_FALSE(values.HasChanges(sendMessage.Values));
+        }
+    }
+
+    SECTION("ServerMessageBundle")
+    {
+        Buffer messageBuff(1000);
+
+        ServerScriptUpdate innerMessage;
+        innerMessage.Data.Data.push_back(42);
+
+        Buffer::Writer messageWriter(&messageBuff);
+        innerMessage.Serialize(messageWriter);
+
+        ServerMessageBundle sendMessage, recvMessage;
+        sendMessage.Add(messageBuff.GetData(), messageWriter.Size());
+        sendMessage.Add(messageBuff.GetData(), messageWriter.Size());
+
+        Buffer buff(1000);
+        Buffer::Writer writer(&buff);
+        sendMessage.Serialize(writer);
+
+        Buffer::Reader reader(&buff);
+
+        uint64_t trash;
+        reader.ReadBits(trash, 8); // pop opcode
+
+        recvMessage.DeserializeRaw(reader);
+
+        REQUIRE(sendMessage == recvMessage);
+
+        size_t count = 0;
+        recvMessage.Visit([&count, &innerMessage](const uint8_t* apData, size_t aSize) {
+            ViewBuffer view(const_cast<uint8_t*>(apData), aSize);
+            Buffer::Reader innerReader(&view);
+
+            const ServerMessageFactory factory;
+            auto pMessage = factory.Extract(innerReader);
+
+            REQUIRE(pMessage);
+            REQUIRE(*CastUnique<ServerScriptUpdate>(std::move(pMessage)) == innerMessage);
+
+            ++count;
+        });
+
+        REQUIRE(count == 2);
+    }
+
     GIVEN("ClientReferencesMoveRequest")
     {
         ClientReferencesMoveRequest sendMessage, recvMessage;
@@ -490,3 +912,36 @@ TEST_CASE("Packets", "[encoding.packets]")
         
     }
 }
+
+TEST_CASE("Delivery classes", "[encoding.delivery]")
+{
+    GIVEN("ServerReferencesMoveRequest")
+    {
+        ServerReferencesMoveRequest message;
+        message.Updates[1].UpdatedMovement.Position.x = 42.f;
+
+        REQUIRE(message.GetDeliveryClass() == kUnreliableSequenced);
+
+        message.Updates[2].ActionEvents.emplace_back().ActionId = 12;
+
+        REQUIRE(message.GetDeliveryClass() == kReliableOrdered);
+    }
+
+    GIVEN("ClientReferencesMoveRequest")
+    {
+        ClientReferencesMoveRequest message;
+        message.Updates[1].UpdatedMovement.Position.x = 42.f;
+
+        REQUIRE(message.GetDeliveryClass() == kUnreliableSequenced);
+
+        message.Updates[1].ActionEvents.emplace_back().ActionId = 12;
+
+        REQUIRE(message.GetDeliveryClass() == kReliableOrdered);
+    }
+
+    GIVEN("Messages without an override")
+    {
+        REQUIRE(AuthenticationResponse{}.GetDeliveryClass() == kReliableOrdered);
+        REQUIRE(AssignCharacterRequest{}.GetDeliveryClass() == kReliableOrdered);
+    }
+}
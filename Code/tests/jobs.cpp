@@ -0,0 +1,67 @@
+#include <catch2/catch.hpp>
+
+#include <common/JobPool.h>
+
+#include <atomic>
+#include <vector>
+
+TEST_CASE("Job pool", "[common.jobs]")
+{
+    GIVEN("Pools of every size")
+    {
+        for (size_t threadCount : { 0, 1, 3 })
+        {
+            JobPool pool(threadCount);
+
+            REQUIRE(pool.GetThreadCount() == threadCount);
+
+            for (size_t count : { 0, 1, 2, 1000 })
+            {
+                std::vector<std::atomic<uint32_t>> visits(count);
+
+                REQUIRE_NOTHROW(pool.ParallelFor(count, [&visits](size_t aIndex) { visits[aIndex].fetch_add(1); }));
+
+                for (auto& visit : visits)
+                    REQUIRE(visit == 1);
+            }
+        }
+    }
+
+    GIVEN("An empty range")
+    {
+        JobPool pool(2);
+        std::atomic<uint32_t> calls{ 0 };
+
+        pool.ParallelFor(0, [&calls](size_t) { calls.fetch_add(1); });
+
+        REQUIRE(calls == 0);
+    }
+
+    GIVEN("Nested calls")
+    {
+        JobPool pool(3);
+
+        constexpr size_t cOuter = 16;
+        constexpr size_t cInner = 100;
+
+        std::vector<std::atomic<uint32_t>> visits(cOuter * cInner);
+
+        pool.ParallelFor(cOuter, [&pool, &visits](size_t aOuter) {
+            pool.ParallelFor(cInner, [&visits, aOuter](size_t aInner) { visits[aOuter * cInner + aInner].fetch_add(1); });
+        });
+
+        for (auto& visit : visits)
+            REQUIRE(visit == 1);
+    }
+
+    GIVEN("Back to back jobs")
+    {
+        JobPool pool(3);
+        std::atomic<uint64_t> sum{ 0 };
+
+        for (uint64_t i = 0; i < 200; ++i)
+            pool.ParallelFor(10, [&sum](size_t aIndex) { sum.fetch_add(aIndex); });
+
+        REQUIRE(sum == 200 * 45);
+    }
+}
@@ -0,0 +1,93 @@
+#include <catch2/catch.hpp>
+
+#include <common/MovementHistory.h>
+
+#include <glm/gtc/constants.hpp>
+
+#include <cmath>
+
+TEST_CASE("Movement history", "[common.movement]")
+{
+    const glm::vec3 cZero{};
+
+    GIVEN("A history that wrapped around")
+    {
+        MovementHistory history(4);
+
+        for (uint64_t tick = 1; tick <= 6; ++tick)
+            history.Record(tick * 10, glm::vec3(static_cast<float>(tick), 0.f, 0.f), cZero);
+
+        REQUIRE(history.GetCapacity() == 4);
+        REQUIRE(history.GetSize() == 4);
+
+        glm::vec3 position, rotation;
+
+        // 10 and 20 were overwritten
+        REQUIRE_FALSE(history.Sample(20, position, rotation));
+
+        REQUIRE(history.Sample(30, position, rotation));
+        REQUIRE(position.x == 3.f);
+
+        REQUIRE(history.Sample(55, position, rotation));
+        REQUIRE(position.x == Approx(5.5f));
+    }
+
+    GIVEN("Samples arriving out of order")
+    {
+        MovementHistory history(4);
+
+        history.Record(10, glm::vec3(1.f, 0.f, 0.f), cZero);
+        history.Record(20, glm::vec3(2.f, 0.f, 0.f), cZero);
+        history.Record(15, glm::vec3(100.f, 0.f, 0.f), cZero);
+        history.Record(20, glm::vec3(100.f, 0.f, 0.f), cZero);
+
+        REQUIRE(history.GetSize() == 2);
+
+        glm::vec3 position, rotation;
+
+        REQUIRE(history.Sample(15, position, rotation));
+        REQUIRE(position.x == Approx(1.5f));
+
+        REQUIRE(history.Sample(20, position, rotation));
+        REQUIRE(position.x == 2.f);
+    }
+
+    GIVEN("Lookups outside of the recorded range")
+    {
+        MovementHistory history(8);
+
+        glm::vec3 position, rotation;
+        REQUIRE_FALSE(history.Sample(10, position, rotation));
+
+        history.Record(10, glm::vec3(1.f, 0.f, 0.f), cZero);
+        history.Record(20, glm::vec3(2.f, 0.f, 0.f), cZero);
+
+        REQUIRE_FALSE(history.Sample(9, position, rotation));
+
+        REQUIRE(history.Sample(10, position, rotation));
+        REQUIRE(position.x == 1.f);
+
+        // Past the latest sample there is nothing to extrapolate from, the latest one is returned
+        REQUIRE(history.Sample(1000, position, rotation));
+        REQUIRE(position.x == 2.f);
+    }
+
+    GIVEN("Rotations crossing the wrap point")
+    {
+        MovementHistory history(2);
+
+        const auto cPi = glm::pi<float>();
+
+        history.Record(10, cZero, glm::vec3(0.f, 0.f, 2.f * cPi - 0.2f));
+        history.Record(20, cZero, glm::vec3(0.f, 0.f, 0.2f));
+
+        glm::vec3 position, rotation;
+
+        // Halfway takes the short way through 2 pi rather than back through pi
+        REQUIRE(history.Sample(15, position, rotation));
+        REQUIRE(std::remainder(rotation.z, 2.f * cPi) == Approx(0.f).margin(1e-4f));
+
+        REQUIRE(history.Sample(20, position, rotation));
+        REQUIRE(rotation.z == 0.2f);
+    }
+}
@@ -0,0 +1,331 @@
+#include <catch2/catch.hpp>
+
+#include <stdafx.h>
+
+#include <MovementReplication.h>
+#include <Components.h>
+
+#include <Messages/ServerReferencesMoveRequest.h>
+#include <common/JobPool.h>
+
+#include <thread>
+
+using namespace TiltedPhoques;
+
+namespace
+{
+constexpr uint32_t cCharacterCount = 64;
+
+// Synthetic per recipient workload for the benchmark, every recipient receives the characters it doesn't own
+void EncodeRecipient(size_t aRecipient, std::vector<uint8_t>& aData)
+{
+    ServerReferencesMoveRequest message;
+    message.Tick = 123456;
+
+    for (uint32_t i = 0; i < cCharacterCount; ++i)
+    {
+        if (i == aRecipient)
+            continue;
+
+        auto& update = message.Updates[i];
+        update.UpdatedMovement.Position.x = 1000.f + i;
+        update.UpdatedMovement.Position.y = -2000.f - i;
+        update.UpdatedMovement.Position.z = 300.f;
+        update.UpdatedMovement.Rotation.x = 0.1f * i;
+        update.UpdatedMovement.Direction = 0.5f;
+        update.UpdatedMovement.Variables.Floats.push_back(42.f);
+
+        auto& action = update.ActionEvents.emplace_back();
+        action.ActionId = i;
+        action.Tick = 48 + i;
+        action.EventName = "moveStart";
+    }
+
+    Buffer buffer(1 << 16);
+    Buffer::Writer writer(&buffer);
+    message.Serialize(writer);
+
+    aData.assign(buffer.GetWriteData(), buffer.GetWriteData() + writer.Size());
+}
+
+void EncodeSequential(std::vector<std::vector<uint8_t>>& aRecipients)
+{
+    for (size_t i = 0; i < aRecipients.size(); ++i)
+        EncodeRecipient(i, aRecipients[i]);
+}
+
+void EncodeParallel(JobPool& aPool, std::vector<std::vector<uint8_t>>& aRecipients)
+{
+    aPool.ParallelFor(aRecipients.size(), [&aRecipients](size_t aIndex) {
+        EncodeRecipient(aIndex, aRecipients[aIndex]);
+    });
+}
+
+constexpr uint32_t cWorldEntityCount = 5000;
+constexpr uint32_t cWorldRecipientCount = 16;
+constexpr uint32_t cCellCount = 8;
+
+// Movement state as it used to be stored, animation variables on the heap next to the hot fields
+struct InterleavedMovement
+{
+    uint64_t Tick;
+    glm::vec3 Position;
+    glm::vec3 Rotation;
+    uint64_t Booleans;
+    Vector<uint32_t> Integers;
+    Vector<float> Floats;
+    float Direction;
+    uint32_t Cell;
+    uint32_t Owner;
+    bool Sent;
+};
+
+// Hot fields only, the way MovementComponent is stored now
+struct HotMovement
+{
+    uint64_t Tick;
+    glm::vec3 Position;
+    glm::vec3 Rotation;
+    float Direction;
+    bool Sent;
+};
+
+struct MovementWorld
+{
+    MovementWorld()
+    {
+        for (uint32_t i = 0; i < cWorldEntityCount; ++i)
+        {
+            // A tenth of the world moves every pass
+            const bool cSent = (i * 7919u) % 10 != 0;
+
+            auto& interleaved = Interleaved.emplace_back();
+            interleaved.Tick = i;
+            interleaved.Position = glm::vec3(i, -1.f * i, 300.f);
+            interleaved.Rotation = glm::vec3(0.1f * i, 0.f, 0.2f);
+            interleaved.Booleans = i;
+            interleaved.Integers.assign(4, i);
+            interleaved.Floats.assign(16, 0.5f * i);
+            interleaved.Direction = 0.5f;
+            interleaved.Cell = i % cCellCount;
+            interleaved.Owner = i % cWorldRecipientCount;
+            interleaved.Sent = cSent;
+
+            Hot.push_back({ interleaved.Tick, interleaved.Position, interleaved.Rotation, interleaved.Direction, cSent });
+            Cells.push_back(interleaved.Cell);
+            Owners.push_back(interleaved.Owner);
+
+            auto& variables = Variables.emplace_back();
+            variables.Booleans = interleaved.Booleans;
+            variables.Integers.assign(4, i);
+            variables.Floats.assign(16, 0.5f * i);
+        }
+    }
+
+    std::vector<InterleavedMovement> Interleaved;
+
+    std::vector<HotMovement> Hot;
+    std::vector<uint32_t> Cells;
+    std::vector<uint32_t> Owners;
+    std::vector<AnimationVariables> Variables;
+};
+
+// Every recipient walks the whole world and picks what it can see, like the registry views used to
+size_t ReplicateInterleaved(const MovementWorld& acWorld, std::vector<Movement>& aOut)
+{
+    aOut.clear();
+
+    for (uint32_t recipient = 0; recipient < cWorldRecipientCount; ++recipient)
+    {
+        for (const auto& entry : acWorld.Interleaved)
+        {
+            if (entry.Sent || entry.Cell != recipient % cCellCount || entry.Owner == recipient)
+                continue;
+
+            auto& movement = aOut.emplace_back();
+            movement.Position = entry.Position;
+            movement.Rotation.x = entry.Rotation.x;
+            movement.Rotation.y = entry.Rotation.z;
+            movement.Direction = entry.Direction;
+            movement.Variables.Booleans = entry.Booleans;
+            movement.Variables.Integers.resize(entry.Integers.size());
+            std::copy(std::begin(entry.Integers), std::end(entry.Integers), std::begin(movement.Variables.Integers));
+            movement.Variables.Floats.resize(entry.Floats.size());
+            std::copy(std::begin(entry.Floats), std::end(entry.Floats), std::begin(movement.Variables.Floats));
+        }
+    }
+
+    return aOut.size();
+}
+
+// A linear scan of the hot data gathers what moved once, like MovementReplication::Gather
+size_t ReplicateDense(const MovementWorld& acWorld, std::vector<uint32_t>& aMoved, std::vector<Movement>& aUpdates, std::vector<Movement>& aOut)
+{
+    aMoved.clear();
+    aUpdates.clear();
+    aOut.clear();
+
+    for (uint32_t i = 0; i < acWorld.Hot.size(); ++i)
+    {
+        const auto& hot = acWorld.Hot[i];
+        if (hot.Sent)
+            continue;
+
+        aMoved.push_back(i);
+
+        auto& movement = aUpdates.emplace_back();
+        movement.Position = hot.Position;
+        movement.Rotation.x = hot.Rotation.x;
+        movement.Rotation.y = hot.Rotation.z;
+        movement.Direction = hot.Direction;
+        movement.Variables = acWorld.Variables[i];
+    }
+
+    for (uint32_t recipient = 0; recipient < cWorldRecipientCount; ++recipient)
+    {
+        for (size_t i = 0; i < aMoved.size(); ++i)
+        {
+            if (acWorld.Cells[aMoved[i]] != recipient % cCellCount || acWorld.Owners[aMoved[i]] == recipient)
+                continue;
+
+            aOut.push_back(aUpdates[i]);
+        }
+    }
+
+    return aOut.size();
+}
+}
+
+TEST_CASE("Parallel replication encoding benchmark", "[.benchmark][replication]")
+{
+    JobPool pool(std::max(2u, std::thread::hardware_concurrency()) - 1);
+
+    for (size_t recipientCount : {16, 32, 64})
+    {
+        std::vector<std::vector<uint8_t>> recipients(recipientCount);
+
+        BENCHMARK("Sequential " + std::to_string(recipientCount) + " recipients")
+        {
+            EncodeSequential(recipients);
+        };
+
+        BENCHMARK("Parallel " + std::to_string(recipientCount) + " recipients")
+        {
+            EncodeParallel(pool, recipients);
+        };
+    }
+}
+
+TEST_CASE("Movement replication pass", "[replication]")
+{
+    entt::registry registry;
+    Vector<entt::entity> dirty;
+
+    const GameId cCell(0, 0x1234);
+    const GameId cOtherCell(0, 0x5678);
+
+    const auto cCreate = [&](ConnectionId_t aOwner, const GameId& acCell, float aX, bool aDirty) {
+        const auto cEntity = registry.create();
+
+        auto& movementComponent = registry.emplace<MovementComponent>(cEntity);
+        movementComponent.Tick = 100;
+        movementComponent.Position = glm::vec3(aX, -aX, 300.f);
+        movementComponent.Rotation = glm::vec3(0.1f, 0.f, 0.2f);
+        movementComponent.Direction = 0.5f;
+        movementComponent.Sent = !aDirty;
+
+        auto& animationComponent = registry.emplace<AnimationComponent>(cEntity);
+        animationComponent.Variables.Floats.push_back(aX);
+        animationComponent.Actions.emplace_back().ActionId = static_cast<uint32_t>(aX);
+
+        registry.emplace<CellIdComponent>(cEntity, acCell);
+        registry.emplace<OwnerComponent>(cEntity, aOwner);
+
+        if (aDirty)
+            dirty.push_back(cEntity);
+
+        return cEntity;
+    };
+
+    const auto cOwned = cCreate(1, cCell, 10.f, true);
+    const auto cMoved = cCreate(2, cCell, 20.f, true);
+    const auto cElsewhere = cCreate(2, cOtherCell, 30.f, true);
+    const auto cIdle = cCreate(3, cCell, 40.f, false);
+    registry.destroy(cCreate(2, cCell, 50.f, true));
+
+    MovementReplication replication;
+    replication.Gather(registry, dirty);
+
+    REQUIRE(dirty.empty());
+    REQUIRE_FALSE(replication.IsEmpty());
+
+    GIVEN("A recipient owning one of the moved characters")
+    {
+        ServerReferencesMoveRequest message;
+        replication.Assemble(1, cCell, message);
+
+        // Its own character, the one in another cell and the idle one are left out
+        REQUIRE(message.Updates.size() == 1);
+
+        const auto& update = message.Updates.at(to_integral(cMoved));
+        REQUIRE(update.UpdatedMovement.Position.x == 20.f);
+        REQUIRE(update.UpdatedMovement.Position.y == -20.f);
+        REQUIRE(update.UpdatedMovement.Rotation.x == 0.1f);
+        REQUIRE(update.UpdatedMovement.Rotation.y == 0.2f);
+        REQUIRE(update.UpdatedMovement.Direction == 0.5f);
+        REQUIRE(update.UpdatedMovement.Variables.Floats.size() == 1);
+        REQUIRE(update.UpdatedMovement.Variables.Floats[0] == 20.f);
+        REQUIRE(update.ActionEvents.size() == 1);
+        REQUIRE(update.ActionEvents[0].ActionId == 20);
+    }
+
+    GIVEN("Recipients that don't own anything")
+    {
+        ServerReferencesMoveRequest message;
+        replication.Assemble(3, cCell, message);
+
+        REQUIRE(message.Updates.size() == 2);
+        REQUIRE(message.Updates.count(to_integral(cOwned)) == 1);
+        REQUIRE(message.Updates.count(to_integral(cMoved)) == 1);
+
+        ServerReferencesMoveRequest otherMessage;
+        replication.Assemble(3, cOtherCell, otherMessage);
+
+        REQUIRE(otherMessage.Updates.size() == 1);
+        REQUIRE(otherMessage.Updates.count(to_integral(cElsewhere)) == 1);
+    }
+
+    GIVEN("The gathered entities")
+    {
+        // Flushed so the next pass only sends new actions, and sent so they can be marked dirty again
+        for (auto entity : { cOwned, cMoved, cElsewhere })
+        {
+            const auto& animationComponent = registry.get<AnimationComponent>(entity);
+
+            REQUIRE(registry.get<MovementComponent>(entity).Sent);
+            REQUIRE(animationComponent.Actions.empty());
+            REQUIRE(animationComponent.LastSerializedAction.ActionId == static_cast<uint32_t>(animationComponent.Variables.Floats[0]));
+        }
+
+        // Not dirty, left alone
+        REQUIRE(registry.get<AnimationComponent>(cIdle).Actions.size() == 1);
+    }
+}
+
+TEST_CASE("Dense movement replication pass benchmark", "[.benchmark][replication]")
+{
+    const MovementWorld world;
+
+    std::vector<uint32_t> moved;
+    std::vector<Movement> updates, out;
+
+    BENCHMARK("Interleaved " + std::to_string(cWorldEntityCount) + " entities")
+    {
+        return ReplicateInterleaved(world, out);
+    };
+
+    BENCHMARK("Dense " + std::to_string(cWorldEntityCount) + " entities")
+    {
+        return ReplicateDense(world, moved, updates, out);
+    };
+}
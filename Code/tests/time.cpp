@@ -0,0 +1,74 @@
+#include <catch2/catch.hpp>
+
+#include <Structs/TimeModel.h>
+
+TEST_CASE("Time model", "[common.time]")
+{
+    GIVEN("A default model")
+    {
+        TimeModel model;
+
+        REQUIRE(model.GetHour(0) == 12.f);
+        REQUIRE(model.GetTimeScale() == 20.f);
+
+        const auto date = model.GetDate(0);
+        REQUIRE(date.Year == 1);
+        REQUIRE(date.Month == 1);
+        REQUIRE(date.Day == 1);
+    }
+
+    GIVEN("Extrapolation over a long session")
+    {
+        TimeModel model;
+        model.EpochTick = 5000;
+        model.GameTime = 0;
+        model.Rate = 20 * TimeModel::kRateUnit;
+
+        // A month of real time at 20x is exactly 600 game days
+        const uint64_t cMonth = 30ull * 24 * 3600 * 1000;
+        REQUIRE(model.GetGameTime(5000 + cMonth) == 600 * TimeModel::kDayLength);
+
+        // Sampling every frame or once gives the same result
+        uint64_t last = 0;
+        for (uint64_t tick = 5000; tick <= 5000 + 100000; tick += 16)
+            last = model.GetGameTime(tick);
+        REQUIRE(last == 100000 * 20);
+
+        // Before the epoch the time holds
+        REQUIRE(model.GetGameTime(10) == 0);
+    }
+
+    GIVEN("Calendar rollover")
+    {
+        REQUIRE(TimeModel::ToDate(31 * TimeModel::kDayLength - 1).Month == 1);
+
+        const auto february = TimeModel::ToDate(31 * TimeModel::kDayLength);
+        REQUIRE(february.Month == 2);
+        REQUIRE(february.Day == 1);
+
+        const auto lastDay = TimeModel::ToDate(364 * TimeModel::kDayLength);
+        REQUIRE(lastDay.Year == 1);
+        REQUIRE(lastDay.Month == 12);
+        REQUIRE(lastDay.Day == 31);
+
+        const auto nextYear = TimeModel::ToDate(365 * TimeModel::kDayLength);
+        REQUIRE(nextYear.Year == 2);
+        REQUIRE(nextYear.Month == 1);
+        REQUIRE(nextYear.Day == 1);
+    }
+
+    GIVEN("Rate and time changes")
+    {
+        TimeModel model;
+        model.SetTimeScale(10.f, 3600 * 1000);
+
+        REQUIRE(model.EpochTick == 3600 * 1000);
+        REQUIRE(model.GameTime == 32 * TimeModel::kHourLength);
+        REQUIRE(model.GetDate(model.EpochTick).Day == 2);
+
+        model.SetTimeOfDay(6 * TimeModel::kHourLength + 30 * TimeModel::kMinuteLength, model.EpochTick);
+        REQUIRE(model.GetHour(model.EpochTick) == 6.5f);
+        REQUIRE(model.GetDate(model.EpochTick).Day == 2);
+        REQUIRE(model.GetGameTime(model.EpochTick + 1000) == model.GameTime + 10000);
+    }
+}
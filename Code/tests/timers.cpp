@@ -0,0 +1,88 @@
+#include <catch2/catch.hpp>
+
+#include <common/TimerWheel.h>
+
+#include <vector>
+
+TEST_CASE("Timer wheel", "[common.timers]")
+{
+    GIVEN("Timers on every level")
+    {
+        TimerWheel wheel(1000);
+        std::vector<uint64_t> fired;
+
+        for (uint64_t delay : {1ull, 63ull, 64ull, 65ull, 4095ull, 4096ull, 300000ull, 20000000ull})
+            wheel.Schedule(delay, [&fired, &wheel, delay]() { fired.push_back(wheel.GetCurrentTick() - 1000); });
+
+        REQUIRE(wheel.GetCount() == 8);
+
+        wheel.Advance(1000 + 20000000);
+
+        REQUIRE(fired == std::vector<uint64_t>{1, 63, 64, 65, 4095, 4096, 300000, 20000000});
+        REQUIRE(wheel.GetCount() == 0);
+    }
+
+    GIVEN("Cancelled timers")
+    {
+        TimerWheel wheel;
+        int calls = 0;
+
+        const auto cKept = wheel.Schedule(10, [&calls]() { ++calls; });
+        const auto cCancelled = wheel.Schedule(10, [&calls]() { calls += 100; });
+
+        wheel.Cancel(cCancelled);
+        // Stale ids are ignored
+        wheel.Cancel(cCancelled);
+        wheel.Advance(20);
+
+        REQUIRE(calls == 1);
+
+        wheel.Cancel(cKept);
+        REQUIRE(wheel.GetCount() == 0);
+    }
+
+    GIVEN("Repeating timers")
+    {
+        TimerWheel wheel;
+        int calls = 0;
+
+        TimerWheel::TimerId id = TimerWheel::kInvalidTimer;
+        id = wheel.ScheduleRepeating(100, [&]() {
+            if (++calls == 3)
+                wheel.Cancel(id);
+        });
+
+        wheel.Advance(150);
+        REQUIRE(calls == 1);
+
+        // Catching up on a long stall only fires once
+        wheel.Advance(1000);
+        REQUIRE(calls == 2);
+
+        for (uint64_t tick = 1000; tick <= 2000; tick += 10)
+            wheel.Advance(tick);
+
+        REQUIRE(calls == 3);
+        REQUIRE(wheel.GetCount() == 0);
+    }
+
+    GIVEN("Timers scheduled from callbacks")
+    {
+        TimerWheel wheel;
+        std::vector<uint64_t> fired;
+
+        wheel.Schedule(5, [&]() {
+            fired.push_back(wheel.GetCurrentTick());
+
+            // Enough of them to grow the pool while the callback runs
+            for (int i = 0; i < 100; ++i)
+                wheel.Schedule(70, [&]() { fired.push_back(wheel.GetCurrentTick()); });
+        });
+
+        wheel.Advance(100);
+
+        REQUIRE(fired.size() == 101);
+        REQUIRE(fired.front() == 5);
+        REQUIRE(fired.back() == 75);
+    }
+}
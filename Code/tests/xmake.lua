@@ -1,16 +1,23 @@
-
 target("TPTests")
     set_kind("binary")
     set_group("Tests")
-    add_defines("TP_SKYRIM=1")
+    add_defines("TP_SKYRIM=1", "CATCH_CONFIG_ENABLE_BENCHMARKING")
     add_includedirs(
-        ".", "../encoding")
+        ".", "../encoding", "../server", "../../Libraries/")
     add_headerfiles("**.h")
     add_files("*.cpp")
-    add_deps("SkyrimEncoding")
+    -- Server passes that run on a bare registry are tested against the real code
+    add_files("../server/MovementReplication.cpp")
+    add_deps("SkyrimEncoding", "Common", "TiltedScript", "TiltedConnect")
     add_packages(
         "tiltedcore",
         "hopscotch-map",
         "catch2",
         "mimalloc",
-        "glm")
+        "glm",
+        "entt",
+        "spdlog",
+        "gamenetworkingsockets",
+        "sqlite3",
+        "lua",
+        "sol2")